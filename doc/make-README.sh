@@ -45,6 +45,8 @@ pc "$(oat framefilt undistort --help)"
 off_u="$pc_res"
 pc "$(oat framefilt thresh --help)" 
 off_t="$pc_res"
+pc "$(oat framefilt motion --help)" 
+off_me="$pc_res"
 
 # oat-view type configurations
 pc "$(oat view frame --help)" 
@@ -57,10 +59,20 @@ pc "$(oat posidet hsv --help)"
 opd_h="$pc_res"
 pc "$(oat posidet thresh --help)" 
 opd_t="$pc_res"
+pc "$(oat posidet multi --help)" 
+opd_m="$pc_res"
+pc "$(oat posidet bands --help)" 
+opd_b="$pc_res"
+pc "$(oat posidet lut --help)" 
+opd_l="$pc_res"
 
 # oat-posigen type configurations
 pc "$(oat posigen rand2D --help)" 
 opg_r2="$pc_res"
+pc "$(oat posigen swarm2D --help)" 
+opg_s="$pc_res"
+pc "$(oat posigen replay --help)" 
+opg_p="$pc_res"
 
 # oat-posifilt type configurations
 pc "$(oat posifilt kalman --help)" 
@@ -69,10 +81,20 @@ pc "$(oat posifilt homography --help)"
 opf_h="$pc_res"
 pc "$(oat posifilt region --help)" 
 opf_r="$pc_res"
+pc "$(oat posifilt smooth --help)" 
+opf_s="$pc_res"
+pc "$(oat posifilt track --help)" 
+opf_t="$pc_res"
+pc "$(oat posifilt savgol --help)" 
+opf_g="$pc_res"
+pc "$(oat posifilt reject --help)" 
+opf_o="$pc_res"
 
 # oat-posicom configurations
 pc "$(oat posicom mean --help)" 
 opc_m="$pc_res"
+pc "$(oat posicom fuse --help)" 
+opc_f="$pc_res"
 
 # oat-posisck configurations
 pc "$(oat posisock std --help)" 
@@ -102,20 +124,31 @@ awk -v ofs="$(oat frameserve --help)" \
     -v off_mo="$off_mo" \
     -v off_u="$off_u" \
     -v off_t="$off_t" \
+    -v off_me="$off_me" \
     -v ovi="$(oat view --help)"      \
     -v ovi_f="$ovi_f" \
     -v opd="$(oat posidet --help)"   \
     -v opd_d="$opd_d" \
     -v opd_h="$opd_h" \
     -v opd_t="$opd_t" \
+    -v opd_m="$opd_m" \
+    -v opd_b="$opd_b" \
+    -v opd_l="$opd_l" \
     -v opg="$(oat posigen --help)"   \
     -v opg_r2="$opg_r2" \
+    -v opg_s="$opg_s" \
+    -v opg_p="$opg_p" \
     -v opf="$(oat posifilt --help)"  \
     -v opf_k="$opf_k" \
     -v opf_h="$opf_h" \
     -v opf_r="$opf_r" \
+    -v opf_s="$opf_s" \
+    -v opf_t="$opf_t" \
+    -v opf_g="$opf_g" \
+    -v opf_o="$opf_o" \
     -v opc="$(oat posicom --help)"  \
     -v opc_m="$opc_m" \
+    -v opc_f="$opc_f" \
     -v ode="$(oat decorate --help)"  \
     -v ore="$(oat record --help)"  \
     -v ops="$(oat posisock --help)"  \
@@ -140,20 +173,31 @@ awk -v ofs="$(oat frameserve --help)" \
     sub(/oat-framefilt-mog-help/, off_mo);
     sub(/oat-framefilt-undistort-help/, off_u);
     sub(/oat-framefilt-thresh-help/, off_t);
+    sub(/oat-framefilt-motion-help/, off_me);
     sub(/oat-view-help/, ovi);
     sub(/oat-view-frame-help/, ovi_f);
     sub(/oat-posidet-help/, opd);
     sub(/oat-posidet-diff-help/, opd_d);
     sub(/oat-posidet-hsv-help/, opd_h);
     sub(/oat-posidet-thresh-help/, opd_t);
+    sub(/oat-posidet-multi-help/, opd_m);
+    sub(/oat-posidet-bands-help/, opd_b);
+    sub(/oat-posidet-lut-help/, opd_l);
     sub(/oat-posigen-help/, opg);
     sub(/oat-posigen-rand2D-help/, opg_r2);
+    sub(/oat-posigen-swarm2D-help/, opg_s);
+    sub(/oat-posigen-replay-help/, opg_p);
     sub(/oat-posifilt-help/, opf);
     sub(/oat-posifilt-kalman-help/, opf_k);
     sub(/oat-posifilt-homography-help/, opf_h);
     sub(/oat-posifilt-region-help/, opf_r);
+    sub(/oat-posifilt-smooth-help/, opf_s);
+    sub(/oat-posifilt-track-help/, opf_t);
+    sub(/oat-posifilt-savgol-help/, opf_g);
+    sub(/oat-posifilt-reject-help/, opf_o);
     sub(/oat-posicom-help/, opc);
     sub(/oat-posicom-mean-help/, opc_m);
+    sub(/oat-posicom-fuse-help/, opc_f);
     sub(/oat-decorate-help/, ode);
     sub(/oat-record-help/, ore);
     sub(/oat-posisock-help/, ops);
@@ -16,18 +16,18 @@ case "$1" in
 
         # decorate 
         sleep 0.1
-        oat decorate RAW FINAL -p ORNG BLUE -sSRt &
+        oat decorate RAW FINAL -p LED_0 LED_1 -sSRt &
 
         sleep 0.1
         oat posifilt kalman COMBO FILT -c config.toml -k kalman &
 
         sleep 0.1
-        oat posicom mean BLUE ORNG COMBO -c config.toml -k mean &
+        oat posicom mean LED_1 LED_0 COMBO -c config.toml -k mean &
 
-        # detecting orange and blue leds in raw data
+        # detecting orange (LED_0) and blue (LED_1) leds in raw data in a
+        # single pass over each frame
         sleep 0.1
-        oat posidet hsv SUB ORNG -c config.toml -k hsv_orange &
-        oat posidet hsv SUB BLUE -c config.toml -k hsv_blue &
+        oat posidet bands SUB LED -c config.toml -k hsv_bands &
 
         # apply mask to determine area of interest, path to mask file is in config
         sleep 0.1
@@ -44,7 +44,7 @@ case "$1" in
 
 	clean)
 
-		oat clean RAW AOI SUB ORNG BLUE COMBO FILT FINAL
+		oat clean RAW AOI SUB LED_0 LED_1 COMBO FILT FINAL
 		;;
 
 	*)
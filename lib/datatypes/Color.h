@@ -30,24 +30,38 @@ enum PixelColor {
     PIX_BINARY = 0,
     PIX_GREY,
     PIX_BGR, // Default
-    PIX_HSV
+    PIX_HSV,
+    // Raw, single channel Bayer mosaics named by the color order of the first
+    // two rows. Order matters: a one pixel shift in x flips bit 0 and a one
+    // pixel shift in y flips bit 1 of (pattern - PIX_BAYER_RGGB).
+    PIX_BAYER_RGGB,
+    PIX_BAYER_GRBG,
+    PIX_BAYER_GBRG,
+    PIX_BAYER_BGGR
 };
 
 // Used conversion structures
-static const int color_2_cvtype[4]{CV_8UC1, CV_8UC1, CV_8UC3, CV_8UC3};
-static const int color_2_bytes[4]{1, 1, 3, 3};
+static const int color_2_cvtype[8]{
+    CV_8UC1, CV_8UC1, CV_8UC3, CV_8UC3, CV_8UC1, CV_8UC1, CV_8UC1, CV_8UC1};
+static const int color_2_bytes[8]{1, 1, 3, 3, 1, 1, 1, 1};
 
-static const int color_2_imread_code[4]{
-    -2, cv::IMREAD_GRAYSCALE, cv::IMREAD_COLOR, -2};
+static const int color_2_imread_code[8]{
+    -2, cv::IMREAD_GRAYSCALE, cv::IMREAD_COLOR, -2, -2, -2, -2, -2};
 
 // Arguments are from/to PixelColors
 // -1 = No conversion needed
 // -2 = Conversion not possible
-static const int color_conv_table[4][4]{
-    {-1, -1, cv::COLOR_GRAY2BGR, -2}, // From BINARY
-    {-1, -1, cv::COLOR_GRAY2BGR, -2}, // From GREY
-    {cv::COLOR_BGR2GRAY, cv::COLOR_BGR2GRAY, -1, cv::COLOR_BGR2HSV}, // From BGR
-    {-2, -2, cv::COLOR_HSV2BGR, -1}, // From HSV
+// NB: OpenCV names Bayer patterns by the second row, second and third
+// columns, hence e.g. RGGB -> cv::COLOR_BayerBG2BGR
+static const int color_conv_table[8][8]{
+    {-1, -1, cv::COLOR_GRAY2BGR, -2, -2, -2, -2, -2}, // From BINARY
+    {-1, -1, cv::COLOR_GRAY2BGR, -2, -2, -2, -2, -2}, // From GREY
+    {cv::COLOR_BGR2GRAY, cv::COLOR_BGR2GRAY, -1, cv::COLOR_BGR2HSV, -2, -2, -2, -2}, // From BGR
+    {-2, -2, cv::COLOR_HSV2BGR, -1, -2, -2, -2, -2}, // From HSV
+    {-2, cv::COLOR_BayerBG2GRAY, cv::COLOR_BayerBG2BGR, -2, -1, -2, -2, -2}, // From BAYER_RGGB
+    {-2, cv::COLOR_BayerGB2GRAY, cv::COLOR_BayerGB2BGR, -2, -2, -1, -2, -2}, // From BAYER_GRBG
+    {-2, cv::COLOR_BayerGR2GRAY, cv::COLOR_BayerGR2BGR, -2, -2, -2, -1, -2}, // From BAYER_GBRG
+    {-2, cv::COLOR_BayerRG2GRAY, cv::COLOR_BayerRG2BGR, -2, -2, -2, -2, -1}, // From BAYER_BGGR
 };
 
 inline std::string color_str(const oat::PixelColor col)
@@ -57,6 +71,10 @@ inline std::string color_str(const oat::PixelColor col)
         case PIX_GREY : return "GREY";
         case PIX_BGR : return "BGR";
         case PIX_HSV : return "HSV";
+        case PIX_BAYER_RGGB : return "BAYER_RGGB";
+        case PIX_BAYER_GRBG : return "BAYER_GRBG";
+        case PIX_BAYER_GBRG : return "BAYER_GBRG";
+        case PIX_BAYER_BGGR : return "BAYER_BGGR";
         default : throw std::runtime_error("Invalid color.");
     }
 }
@@ -71,6 +89,14 @@ inline oat::PixelColor str_color(const std::string &s)
         return PIX_BGR;
     else if (s == "HSV")
         return PIX_HSV;
+    else if (s == "BAYER_RGGB")
+        return PIX_BAYER_RGGB;
+    else if (s == "BAYER_GRBG")
+        return PIX_BAYER_GRBG;
+    else if (s == "BAYER_GBRG")
+        return PIX_BAYER_GBRG;
+    else if (s == "BAYER_BGGR")
+        return PIX_BAYER_BGGR;
     else
         throw std::runtime_error("Invalid color.");
 }
@@ -94,6 +120,20 @@ inline int color_conv_code(oat::PixelColor from, oat::PixelColor to)
     return code;
 }
 
+inline bool is_bayer(oat::PixelColor col)
+{
+    return col >= PIX_BAYER_RGGB && col <= PIX_BAYER_BGGR;
+}
+
+/**
+ * @brief Check if frames of a given color can be demosaiced to another
+ * color by a consumer. HSV is reached via an intermediate BGR frame.
+ */
+inline bool can_demosaic(oat::PixelColor from, oat::PixelColor to)
+{
+    return is_bayer(from) && (to == PIX_GREY || to == PIX_BGR || to == PIX_HSV);
+}
+
 inline int imread_code(oat::PixelColor col)
 {
     auto code = color_2_imread_code[col];
@@ -0,0 +1,96 @@
+//******************************************************************************
+//* File:   Demosaic.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_DEMOSAIC_H
+#define	OAT_DEMOSAIC_H
+
+#include <stdexcept>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "Color.h"
+
+namespace oat {
+
+/**
+ * @brief Bayer pattern seen at pixel (x, y) of a mosaic whose top-left pixel
+ * has pattern p.
+ */
+inline oat::PixelColor bayer_shift(const oat::PixelColor p, const int x, const int y)
+{
+    const int phase = (p - PIX_BAYER_RGGB) ^ ((x & 1) | ((y & 1) << 1));
+    return static_cast<oat::PixelColor>(PIX_BAYER_RGGB + phase);
+}
+
+/**
+ * @brief Demosaic a raw Bayer frame, or a region of it, into a GREY, BGR, or
+ * HSV frame. Only the requested region is interpolated and only into the
+ * requested color, so a consumer that needs intensity alone, or a small
+ * window, does not pay for a full color conversion. Uses OpenCV's
+ * vectorized bilinear Bayer kernels.
+ *
+ * @param raw Single channel Bayer mosaic.
+ * @param pattern Bayer pattern of raw's top-left pixel.
+ * @param out Demosaiced frame of size roi.size(). Reallocated only if its
+ * size or type differ from the result.
+ * @param to Requested output color.
+ * @param roi Region of raw to demosaic. An empty rectangle indicates the
+ * whole frame.
+ */
+inline void demosaic(const cv::Mat &raw,
+                     const oat::PixelColor pattern,
+                     cv::Mat &out,
+                     const oat::PixelColor to,
+                     cv::Rect roi = cv::Rect())
+{
+    if (!oat::can_demosaic(pattern, to))
+        throw std::runtime_error("Requested demosaic is not possible.");
+
+    const cv::Rect frame_rect(0, 0, raw.cols, raw.rows);
+    roi = roi.area() > 0 ? roi & frame_rect : frame_rect;
+
+    // Pad the region by a pixel so that interpolation at its border uses
+    // real neighbours instead of replicated edges
+    const cv::Rect padded
+        = cv::Rect(roi.x - 1, roi.y - 1, roi.width + 2, roi.height + 2)
+          & frame_rect;
+
+    const auto code = oat::color_conv_code(
+        bayer_shift(pattern, padded.x, padded.y),
+        to == PIX_GREY ? PIX_GREY : PIX_BGR);
+
+    if (padded == roi) {
+
+        // Whole frame: convert straight into the output
+        cv::cvtColor(raw(roi), out, code);
+
+    } else {
+
+        cv::Mat tmp;
+        cv::cvtColor(raw(padded), tmp, code);
+        tmp(cv::Rect(roi.x - padded.x, roi.y - padded.y, roi.width, roi.height))
+            .copyTo(out);
+    }
+
+    if (to == PIX_HSV)
+        cv::cvtColor(out, out, cv::COLOR_BGR2HSV);
+}
+
+}      /* namespace oat */
+#endif /* OAT_DEMOSAIC_H */
@@ -129,6 +129,7 @@ public:
 
     // Provide copy of sample_
     oat::Sample sample() const { return *sample_ptr_; };
+    void set_sample(const oat::Sample &val) { *sample_ptr_ = val; }
 
     // Color accessors
     PixelColor color(void) const { return color_; }
@@ -0,0 +1,107 @@
+//******************************************************************************
+//* File:   Homography.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_HOMOGRAPHY_H
+#define	OAT_HOMOGRAPHY_H
+
+#include <cfloat>
+#include <cmath>
+#include <opencv2/core/matx.hpp>
+
+#include "Position2D.h"
+
+namespace oat {
+
+namespace detail {
+
+// Projective transform of (x, y, w) with the translation column of H applied
+// with weight w. Matches cv::perspectiveTransform, including a zero result
+// when the projected scale vanishes.
+inline cv::Point2d project(const cv::Matx33d &H, const cv::Point2d &v, double w)
+{
+    const double z = H(2, 0) * v.x + H(2, 1) * v.y + H(2, 2);
+    const double s = std::abs(z) > DBL_EPSILON ? 1.0 / z : 0.0;
+    return cv::Point2d((H(0, 0) * v.x + H(0, 1) * v.y + w * H(0, 2)) * s,
+                       (H(1, 0) * v.x + H(1, 1) * v.y + w * H(1, 2)) * s);
+}
+
+}      /* namespace detail */
+
+/**
+ * @brief Transform a position's position, velocity, and heading by a 3x3
+ * homography in place. Translation is not applied to velocity or heading,
+ * and heading is renormalized. Operates on the stack only.
+ * @param H Homography.
+ * @param p Position to transform. Its coordinate system is not changed.
+ */
+inline void applyHomography(const cv::Matx33d &H, oat::Position2D &p)
+{
+    if (p.position_valid)
+        p.position = detail::project(H, p.position, 1.0);
+
+    if (p.velocity_valid)
+        p.velocity = detail::project(H, p.velocity, 0.0);
+
+    if (p.heading_valid) {
+        const oat::UnitVector2D h = detail::project(H, p.heading, 0.0);
+        const double norm = std::sqrt(h.dot(h));
+        p.heading = norm > 0 ? h * (1.0 / norm) : h;
+    }
+}
+
+/**
+ * @brief Batched form of applyHomography() for buffered positions, e.g.
+ * when post-processing recorded samples.
+ * @param H Homography.
+ * @param first Iterator to the first position to transform.
+ * @param last Iterator past the last position to transform.
+ */
+template <typename It>
+inline void applyHomography(const cv::Matx33d &H, It first, It last)
+{
+    for (; first != last; ++first)
+        applyHomography(H, *first);
+}
+
+/**
+ * @brief Inverse of a position stream's homography. The inverse is only
+ * recomputed when the stream's homography changes.
+ */
+class HomographyInverse {
+
+public:
+
+    const cv::Matx33d &operator()(const cv::Matx33d &H)
+    {
+        if (H != homography_) {
+            homography_ = H;
+            inverse_ = H.inv();
+        }
+
+        return inverse_;
+    }
+
+private:
+
+    cv::Matx33d homography_ {cv::Matx33d::eye()};
+    cv::Matx33d inverse_ {cv::Matx33d::eye()};
+};
+
+}      /* namespace oat */
+#endif /* OAT_HOMOGRAPHY_H */
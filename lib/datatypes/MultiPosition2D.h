@@ -0,0 +1,134 @@
+//******************************************************************************
+//* File:   MultiPosition2D.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_MULTIPOSITION2D_H
+#define	OAT_MULTIPOSITION2D_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "Position2D.h"
+#include "Sample.h"
+
+namespace oat {
+
+/**
+ * @brief Fixed capacity set of positions measured from a single sample, e.g.
+ * all objects found by a single detection pass. Storage is inline so that it
+ * can be exchanged through shared memory.
+ */
+class MultiPosition2D {
+
+public:
+
+    static constexpr size_t MAX_POSITIONS {32};
+
+    explicit MultiPosition2D(const std::string &label)
+    {
+        strncpy(label_, label.c_str(), sizeof(label_));
+        label_[sizeof(label_) - 1] = '\0';
+    }
+
+    // Copy all but label, which is specific to the component
+    MultiPosition2D &operator=(const MultiPosition2D &p)
+    {
+        // Check for self assignment
+        if (this == &p)
+            return *this;
+
+        sample_ = p.sample_;
+        size_ = p.size_;
+        for (size_t i = 0; i < size_; i++) {
+            positions_[i] = p.positions_[i];
+            ids_[i] = p.ids_[i];
+        }
+
+        return *this;
+    }
+
+    // Accessors
+    char *label() { return label_; }
+    size_t size(void) const { return size_; }
+    bool empty(void) const { return size_ == 0; }
+    bool full(void) const { return size_ == MAX_POSITIONS; }
+    void clear(void) { size_ = 0; }
+
+    Position2D &operator[](const size_t i) { return positions_[i]; }
+    const Position2D &operator[](const size_t i) const { return positions_[i]; }
+    Position2D *begin() { return positions_; }
+    Position2D *end() { return positions_ + size_; }
+    const Position2D *begin() const { return positions_; }
+    const Position2D *end() const { return positions_ + size_; }
+
+    /**
+     * @brief Identity of position i. Positions with the same ID in successive
+     * sets belong to the same object only if the producer tracks identity
+     * (e.g. a multi-object tracker). Otherwise IDs are set indices.
+     */
+    uint32_t id(const size_t i) const { return ids_[i]; }
+
+    /**
+     * @brief Append a position, which is stamped with this set's sample.
+     * @param p Position to append.
+     * @return False if the set is full and p was discarded.
+     */
+    bool push_back(const Position2D &p)
+    {
+        return push_back(p, static_cast<uint32_t>(size_));
+    }
+
+    /**
+     * @brief Append a position with an identity, which is stamped with this
+     * set's sample.
+     * @param p Position to append.
+     * @param id Object identity.
+     * @return False if the set is full and p was discarded.
+     */
+    bool push_back(const Position2D &p, const uint32_t id)
+    {
+        if (full())
+            return false;
+
+        positions_[size_] = p;
+        positions_[size_].set_sample(sample_);
+        ids_[size_] = id;
+        size_++;
+        return true;
+    }
+
+    // Sample accessors
+    void set_sample(const Sample &val) { sample_ = val; }
+    oat::Sample sample() const { return sample_; }
+    uint64_t sample_count(void) const { return sample_.count(); }
+    uint64_t sample_usec(void) const { return sample_.microseconds().count(); }
+
+private:
+
+    char label_[100] {0}; //!< Set label (e.g. "mice")
+
+    oat::Sample sample_;
+
+    size_t size_ {0};
+    Position2D positions_[MAX_POSITIONS];
+    uint32_t ids_[MAX_POSITIONS] {0};
+};
+
+}      /* namespace oat */
+#endif /* OAT_MULTIPOSITION2D_H */
@@ -19,6 +19,8 @@
 
 #include "Position2D.h"
 
+#include <cstring>
+
 namespace oat {
 
 const char Position2D::NPY_DTYPE[]{"[('tick', '<u8'),"
@@ -95,4 +97,32 @@ std::vector<char> packPosition(const Position2D &p)
     return pack;
 }
 
+void unpackPosition(const char *record, Position2D &p)
+{
+    // Field offsets follow NPY_DTYPE, skipping tick and usec
+    const char *r = record + 2 * sizeof(uint64_t);
+
+    int u;
+    std::memcpy(&u, r, sizeof(u));
+    p.unit_of_length_ = static_cast<DistanceUnit>(u);
+    r += sizeof(u);
+
+    const auto unpack_xy = [&r](bool &ok, cv::Point2d &xy) {
+        ok = *r++ != 0;
+        std::memcpy(&xy.x, r, sizeof(xy.x));
+        r += sizeof(xy.x);
+        std::memcpy(&xy.y, r, sizeof(xy.y));
+        r += sizeof(xy.y);
+    };
+
+    unpack_xy(p.position_valid, p.position);
+    unpack_xy(p.velocity_valid, p.velocity);
+    unpack_xy(p.heading_valid, p.heading);
+
+    // Region
+    p.region_valid = *r++ != 0;
+    std::memcpy(p.region, r, Position2D::REGION_LEN);
+    p.region[Position2D::REGION_LEN - 1] = '\0';
+}
+
 } /* namespace oat */
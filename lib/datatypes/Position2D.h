@@ -53,6 +53,14 @@ void serializePosition(const Position2D &p, Writer &w, bool verbose = false);
  */
 std::vector<char> packPosition(const Position2D &p);
 
+/**
+ * @brief Unpack a position object from a byte array written by
+ * packPosition(). Sample information is not restored.
+ * @param record NPY_DTYPE_BYTES long byte array.
+ * @param p Position to unpack into.
+ */
+void unpackPosition(const char *record, Position2D &p);
+
 /**
  * Unit of length used to specify position.
  */
@@ -68,11 +76,15 @@ class Position2D {
     friend void
     serializePosition(const Position2D &, Writer &, bool verbose);
     friend std::vector<char> packPosition(const Position2D &);
+    friend void unpackPosition(const char *, Position2D &);
 
     using USec = Sample::Microseconds;
 
 public:
 
+    // Unlabeled position, e.g. an element of a MultiPosition2D
+    Position2D() { }
+
     explicit Position2D(const std::string &label)
     {
         strncpy(label_, label.c_str(), sizeof(label_));
@@ -130,6 +142,7 @@ public:
     void set_sample(const Sample &val) { sample_ = val; }
     void set_rate_hz(const double rate_hz) { sample_.set_rate_hz(rate_hz); }
     double sample_period_sec() const { return sample_.period_sec().count(); }
+    const oat::Sample &sample(void) const { return sample_; }
     uint64_t sample_count(void) const { return sample_.count(); }
     uint64_t sample_usec(void) const { return sample_.microseconds().count(); }
     void incrementSampleCount() { sample_.incrementCount(); }
@@ -34,6 +34,10 @@ struct FrameParams {
     int type  {0};
     oat::PixelColor color {oat::PIX_BGR};
     size_t bytes {0};
+
+    // Region of the frame that can contain non-zero pixels. Empty indicates
+    // the whole frame.
+    cv::Rect roi;
 };
 
 /** Header to facilitate zero-copy oat::Frame exchange through shared
@@ -81,6 +85,14 @@ public :
         params_.color = color;
     }
 
+    /**
+     * Set the region of the frame that can contain non-zero pixels so that
+     * sources can skip the remainder.
+     *
+     * @param roi Region of interest. Empty indicates the whole frame.
+     */
+    void set_roi(const cv::Rect &roi) { params_.roi = roi; }
+
 private :
 
     // TODO: Should these be atomic? They should already be protected by
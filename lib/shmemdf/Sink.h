@@ -227,6 +227,7 @@ public:
     void bind(const std::string &address, const size_t bytes);
     oat::Frame retrieve(const size_t rows, size_t cols, const int type, const
             oat::PixelColor color);
+    void set_roi(const cv::Rect &roi);
 };
 
 inline void Sink<Frame>::bind(const std::string &address, const size_t bytes)
@@ -297,6 +298,16 @@ inline oat::Frame Sink<Frame>::retrieve(const size_t rows,
     return oat::Frame(rows, cols, type, color, data, sample);
 }
 
+inline void Sink<Frame>::set_roi(const cv::Rect &roi)
+{
+    if (!bound_)
+        throw (std::runtime_error("SINK must be bound before its region of interest is set."));
+
+    // NB: Sources read this when they connect, which happens after the first
+    // post(), so it must be set before then
+    sh_object_->set_roi(roi);
+}
+
 } // namespace oat
 
 #endif	/* OAT_SINK_H */
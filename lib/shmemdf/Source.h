@@ -24,6 +24,7 @@
 #include "Node.h"
 #include "SharedFrameHeader.h"
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <memory>
@@ -61,8 +62,14 @@ public:
 
     // Sychronization
     NodeState wait();
+    bool waitUntil(const boost::system_time &deadline);
     void post();
 
+    NodeState sink_state() const
+    {
+        return (node_ == nullptr ? NodeState::UNDEFINED : node_->sink_state());
+    }
+
     uint64_t write_number() const
     {
         return (node_ == nullptr ? 0 : node_->write_number());
@@ -214,6 +221,48 @@ inline NodeState SourceBase<T>::wait()
     return node_->sink_state();
 }
 
+/**
+ * @brief Wait for the sink to write, but only until deadline. Use to service
+ * several sources without letting one that has stalled block the others.
+ * @param deadline Time at which to give up waiting.
+ * @return True if the wait completed, in which case it must be followed by
+ * post() exactly as for wait(), and the node state should be checked using
+ * sink_state(). False if the deadline expired first, in which case post() must
+ * not be called.
+ */
+template <typename T>
+inline bool SourceBase<T>::waitUntil(const boost::system_time &deadline)
+{
+#ifndef NDEBUG
+    // Don't use Asserts because it does not clean shmem
+    if(state_ < SourceState::TOUCHED)
+        throw std::runtime_error("Source must have touched node before calling waitUntil()");
+    if (did_wait_need_post_)
+        throw std::runtime_error("waitUntil() called when post() was required.");
+#endif
+
+    boost::system_time timeout
+        = std::min(deadline, boost::get_system_time() + msec_t(10));
+
+    // Same as wait(), but give up once the deadline has passed
+    while (!node_->read_barrier(slot_index_).timed_wait(timeout) && !quit) {
+
+        // If the sink has left the room, we should too
+        if (node_->sink_state() == NodeState::END)
+            break;
+
+        const boost::system_time now = boost::get_system_time();
+        if (now >= deadline)
+            return false;
+
+        timeout = std::min(deadline, now + msec_t(10));
+    }
+
+    did_wait_need_post_ = true;
+
+    return true;
+}
+
 template <typename T>
 inline void SourceBase<T>::post()
 {
@@ -301,8 +350,9 @@ inline SourceState Source<Frame>::connect(const oat::PixelColor color)
 {
     auto rc = connect();
 
-    // Check frame pixel type if required
-    if (frame_.color() != color) {
+    // Check frame pixel type if required. Raw Bayer frames are accepted if the
+    // consumer can demosaic them to the required color itself.
+    if (frame_.color() != color && !oat::can_demosaic(frame_.color(), color)) {
         throw std::runtime_error("Component requires frame source "
                                  "with pixels of type "
                                  + oat::color_str(color)
@@ -362,6 +412,7 @@ inline SourceState Source<Frame>::connect()
     parameters_.type = p.type;
     parameters_.color = p.color;
     parameters_.bytes = frame_.total() * frame_.elemSize();
+    parameters_.roi = p.roi;
 
     state_ = SourceState::CONNECTED;
     return SourceState::CONNECTED;
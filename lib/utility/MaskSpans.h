@@ -0,0 +1,145 @@
+//******************************************************************************
+//* File:   MaskSpans.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_MASKSPANS_H
+#define	OAT_MASKSPANS_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <opencv2/core.hpp>
+
+#include "ParallelRows.h"
+
+namespace oat {
+
+/**
+ * @brief Run-length form of a static binary mask. Applying it zeroes the
+ * pixels of a frame that correspond to zero mask pixels, which is equivalent
+ * to frame.setTo(0, mask == 0) but touches only the masked-out spans and
+ * needs no per-frame comparison.
+ */
+class MaskSpans {
+
+public:
+    /**
+     * @brief Convert a mask to spans.
+     * @param mask Single channel, 8-bit mask. Non-zero pixels are kept.
+     */
+    void build(const cv::Mat &mask)
+    {
+        size_ = mask.size();
+        spans_.clear();
+        row_spans_.assign(1, 0);
+
+        // Bounding box of kept (non-zero) pixels and whether each row keeps
+        // a single run
+        int x0 = mask.cols, x1 = 0, y0 = mask.rows, y1 = 0;
+        bool rectangular = true;
+
+        for (int r = 0; r < mask.rows; r++) {
+
+            const uint8_t *m = mask.ptr<uint8_t>(r);
+            int keep_start = -1, keep_end = -1, keep_runs = 0;
+
+            int c = 0;
+            while (c < mask.cols) {
+
+                const int start = c;
+                const bool keep = m[c] != 0;
+                while (c < mask.cols && (m[c] != 0) == keep)
+                    c++;
+
+                if (keep) {
+                    keep_start = start;
+                    keep_end = c;
+                    keep_runs++;
+                } else {
+                    spans_.emplace_back(start, c);
+                }
+            }
+
+            row_spans_.push_back(spans_.size());
+
+            if (keep_runs == 0)
+                continue;
+
+            // Kept pixels must be one run per row, share columns with every
+            // other kept row, and those rows must be contiguous
+            if (keep_runs > 1
+                || (y1 > 0 && (y1 != r || keep_start != x0 || keep_end != x1)))
+                rectangular = false;
+
+            x0 = std::min(x0, keep_start);
+            x1 = std::max(x1, keep_end);
+            y0 = std::min(y0, r);
+            y1 = r + 1;
+        }
+
+        box_ = rectangular && y1 > y0 ? cv::Rect(x0, y0, x1 - x0, y1 - y0)
+                                      : cv::Rect();
+    }
+
+    /**
+     * @brief Zero the masked-out pixels of a frame in parallel row bands.
+     * @param frame Frame of any type with the size of the mask.
+     */
+    void apply(cv::Mat &frame) const
+    {
+        const size_t px_bytes = frame.elemSize();
+
+        parallelRows(frame.rows, [&](const cv::Range &rows) {
+
+            for (int r = rows.start; r < rows.end; r++) {
+
+                uint8_t *row = frame.ptr<uint8_t>(r);
+                for (size_t s = row_spans_[r]; s < row_spans_[r + 1]; s++)
+                    std::memset(row + spans_[s].start * px_bytes,
+                                0,
+                                spans_[s].size() * px_bytes);
+            }
+        });
+    }
+
+    /**
+     * @brief Size of the mask the spans were built from.
+     */
+    cv::Size size(void) const { return size_; }
+
+    /**
+     * @brief Bounding box of the mask's non-zero pixels if they form a
+     * rectangle.
+     * @return Box. Empty if the kept pixels do not form a single rectangle.
+     */
+    cv::Rect box(void) const { return box_; }
+
+private:
+    cv::Size size_;
+
+    // Column spans to zero, [start, end), in row-major order. Spans for row r
+    // are spans_[row_spans_[r]] to spans_[row_spans_[r + 1] - 1].
+    std::vector<cv::Range> spans_;
+    std::vector<size_t> row_spans_ {0};
+
+    cv::Rect box_;
+};
+
+}      /* namespace oat */
+#endif /* OAT_MASKSPANS_H */
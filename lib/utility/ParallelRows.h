@@ -0,0 +1,103 @@
+//******************************************************************************
+//* File:   ParallelRows.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_PARALLELROWS_H
+#define	OAT_PARALLELROWS_H
+
+#include <algorithm>
+#include <boost/program_options.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/core/utility.hpp>
+
+#include "TOMLSanitize.h"
+
+namespace oat {
+
+namespace po = boost::program_options;
+
+namespace detail {
+
+template <typename Body>
+class RowBandLoop : public cv::ParallelLoopBody {
+public:
+    explicit RowBandLoop(const Body &body) : body_(body) { }
+    void operator()(const cv::Range &rows) const override { body_(rows); }
+
+private:
+    const Body &body_;
+};
+
+}      /* namespace detail */
+
+/**
+ * @brief Split the rows [0, rows) into contiguous bands and call body on
+ * each from OpenCV's persistent worker pool. Blocks until all bands are
+ * complete. Bands must be independent: body may only write to the rows it is
+ * given.
+ * @param rows Number of rows to process.
+ * @param body Callable with signature void(const cv::Range &rows).
+ * @param min_band_rows Minimum rows per band. Use to bound per-band
+ * overhead, e.g. overlap required by spatial filters.
+ */
+template <typename Body>
+inline void parallelRows(const int rows,
+                         const Body &body,
+                         const int min_band_rows = 16)
+{
+    const int n_bands = std::max(
+        1, std::min(cv::getNumThreads(), rows / std::max(min_band_rows, 1)));
+
+    if (n_bands == 1)
+        body(cv::Range(0, rows));
+    else
+        cv::parallel_for_(cv::Range(0, rows),
+                          detail::RowBandLoop<Body>(body),
+                          n_bands);
+}
+
+/**
+ * @brief Append worker thread count option used by parallelRows().
+ * @param opts Options to append to.
+ */
+inline void appendThreadOptions(po::options_description &opts)
+{
+    opts.add_options()
+        ("threads", po::value<int>(),
+         "Number of threads used to process each frame in parallel row "
+         "bands. Set to 1 to process on a single core. Defaults to the number "
+         "of CPU cores.")
+        ;
+}
+
+/**
+ * @brief Apply worker thread count option used by parallelRows(). Threads are
+ * created once per process and persist between frames.
+ * @param vm Pre-parse program option map.
+ * @param config_table Parsed TOML options table.
+ */
+inline void applyThreadConfiguration(const po::variables_map &vm,
+                                     const config::OptionTable &config_table)
+{
+    int threads;
+    if (oat::config::getNumericValue<int>(vm, config_table, "threads", threads, 1))
+        cv::setNumThreads(threads);
+}
+
+}      /* namespace oat */
+#endif /* OAT_PARALLELROWS_H */
@@ -0,0 +1,86 @@
+//******************************************************************************
+//* File:   Rectify.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_RECTIFY_H
+#define	OAT_RECTIFY_H
+
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/calib3d.hpp>
+
+#include "ParallelRows.h"
+
+namespace oat {
+
+/**
+ * @brief Build lens distortion compensation maps. These are the same maps,
+ * in the same fixed-point format, that cv::undistort() builds internally on
+ * every call, so they can be built once for a fixed frame size and applied
+ * with rectify().
+ * @param camera_matrix 3x3 camera matrix.
+ * @param dist_coeff Five to eight lens distortion coefficients.
+ * @param size Frame size.
+ * @param map_xy Fixed-point pixel coordinate map output.
+ * @param map_interp Interpolation table index map output.
+ */
+inline void buildRectifyMaps(const cv::Matx33d &camera_matrix,
+                             const std::vector<double> &dist_coeff,
+                             const cv::Size &size,
+                             cv::Mat &map_xy,
+                             cv::Mat &map_interp)
+{
+    cv::initUndistortRectifyMap(camera_matrix,
+                                dist_coeff,
+                                cv::Mat(),
+                                camera_matrix,
+                                size,
+                                CV_16SC2,
+                                map_xy,
+                                map_interp);
+}
+
+/**
+ * @brief Apply maps built by buildRectifyMaps() in parallel row bands. Each
+ * band reads from anywhere in the input but only writes its own rows of the
+ * output. Map rows are contiguous, so bands stay in cache.
+ * @param in Distorted frame.
+ * @param out Compensated frame. Must be allocated with the size and type of
+ * in and must not share its data.
+ * @param map_xy Fixed-point pixel coordinate map.
+ * @param map_interp Interpolation table index map.
+ */
+inline void rectify(const cv::Mat &in,
+                    cv::Mat &out,
+                    const cv::Mat &map_xy,
+                    const cv::Mat &map_interp)
+{
+    parallelRows(in.rows, [&](const cv::Range &rows) {
+        cv::Mat dst = out.rowRange(rows);
+        cv::remap(in,
+                  dst,
+                  map_xy.rowRange(rows),
+                  map_interp.rowRange(rows),
+                  cv::INTER_LINEAR,
+                  cv::BORDER_CONSTANT);
+    });
+}
+
+}      /* namespace oat */
+#endif /* OAT_RECTIFY_H */
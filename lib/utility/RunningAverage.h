@@ -0,0 +1,91 @@
+//******************************************************************************
+//* File:   RunningAverage.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_RUNNINGAVERAGE_H
+#define	OAT_RUNNINGAVERAGE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <opencv2/core.hpp>
+
+#include "ParallelRows.h"
+
+namespace oat {
+
+/**
+ * @brief Convert a running average update rate to Q0.15 fixed-point.
+ * @param alpha Update rate, 0 to 1.
+ * @return Fixed-point rate. At least 1 for non-zero rates so that the
+ * average still adapts.
+ */
+inline int32_t runningAverageRate(const double alpha)
+{
+    if (alpha <= 0.0)
+        return 0;
+
+    return std::max<int32_t>(std::lround(alpha * (1 << 15)), 1);
+}
+
+/**
+ * @brief Update a Q8.8 fixed-point running average with a frame and then
+ * subtract the average from the frame, saturating at zero, in a single pass.
+ * Equivalent, to within a grey level, to cv::accumulateWeighted() followed
+ * by rounding the average to 8 bits and cv::subtract(). Integer arithmetic
+ * only, so the inner loop auto-vectorizes.
+ * @param frame 8-bit frame. Replaced by the difference.
+ * @param average_q8 16-bit running average scaled by 256. Must have the
+ * size and number of channels of frame.
+ * @param alpha_q15 Update rate from runningAverageRate().
+ */
+inline void subtractRunningAverage(cv::Mat &frame,
+                                   cv::Mat &average_q8,
+                                   const int32_t alpha_q15)
+{
+    CV_Assert(frame.depth() == CV_8U && average_q8.depth() == CV_16U
+              && frame.size() == average_q8.size()
+              && frame.channels() == average_q8.channels());
+
+    const int n = frame.cols * frame.channels();
+    const int32_t a = alpha_q15;
+
+    parallelRows(frame.rows, [&](const cv::Range &rows) {
+
+        for (int r = rows.start; r < rows.end; r++) {
+
+            uint8_t *px = frame.ptr<uint8_t>(r);
+            uint16_t *bg = average_q8.ptr<uint16_t>(r);
+
+            for (int i = 0; i < n; i++) {
+
+                // bg += alpha * (px - bg), rounded. |diff * a| < 2^31.
+                const int32_t diff = (static_cast<int32_t>(px[i]) << 8) - bg[i];
+                const int32_t b = bg[i] + ((diff * a + (1 << 14)) >> 15);
+                bg[i] = static_cast<uint16_t>(b);
+
+                // px = saturate(px - round(bg))
+                const int32_t d = px[i] - ((b + 128) >> 8);
+                px[i] = static_cast<uint8_t>(d > 0 ? d : 0);
+            }
+        }
+    });
+}
+
+}      /* namespace oat */
+#endif /* OAT_RUNNINGAVERAGE_H */
@@ -324,6 +324,42 @@ getArray(const po::variables_map &vm,
     }
 }
 
+// TOML array of strings from table
+template <>
+inline bool
+getArray<std::string>(const po::variables_map &vm,
+                      const OptionTable table,
+                      const std::string& key,
+                      std::vector<std::string> &array_out,
+                      bool required) {
+
+    OptionTable t;
+
+    if (vm.count(key)) {
+
+        std::istringstream toml {key + "=" + vm[key].as<std::string>()};
+        cpptoml::parser p {toml};
+        t = p.parse();
+
+    } else if (table->contains(key)) {
+
+        t = table;
+
+    } else if (required) {
+        throw (std::runtime_error("Required configuration value '" + key + "' was not specified."));
+    } else {
+        return false;
+    }
+
+    if (t->get(key)->is_array()) {
+        auto out = *t->get_array_of<std::string>(key);
+        array_out.assign(out.begin(), out.end());
+        return true;
+    } else {
+        throw (std::runtime_error("'" + key + "' must be a TOML array."));
+    }
+}
+
 // TOML array from table, required size
 template <typename T, size_t size>
 bool
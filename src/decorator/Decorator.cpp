@@ -157,6 +157,7 @@ bool Decorator::connectToNode()
     if (decorate_position_) {
         previous_positions_.push_back(oat::Point2D(0,0));
         positions_found_.push_back(false);
+        homography_inverses_.resize(position_sources_.size());
         history_frame_ = cv::Mat::zeros(shared_frame_.size(), shared_frame_.type());
     }
 
@@ -255,43 +256,11 @@ void Decorator::drawOnFrame()
         encodeSampleNumber();
 }
 
-void Decorator::invertHomography(oat::Position2D &p)
+void Decorator::invertHomography(oat::Position2D &p,
+                                 oat::HomographyInverse &inverse)
 {
-    if (p.position_valid) {
-
-        cv::Matx33d inv_homo = p.homography().inv();
-
-        std::vector<oat::Point2D> in_positions;
-        std::vector<oat::Point2D> out_positions;
-        in_positions.push_back(p.position);
-        cv::perspectiveTransform(in_positions, out_positions, inv_homo);
-        p.position = out_positions[0];
-
-        if (p.velocity_valid) {
-
-            std::vector<oat::Velocity2D> in_velocities;
-            std::vector<oat::Velocity2D> out_velocities;
-            cv::Matx33d vel_inv_homo = inv_homo;
-            vel_inv_homo(0, 2) = 0.0; // offsets do not apply to velocity
-            vel_inv_homo(1, 2) = 0.0; // offsets do not apply to velocity
-            in_velocities.push_back(p.velocity);
-            cv::perspectiveTransform(in_velocities, out_velocities, vel_inv_homo);
-            p.velocity = out_velocities[0];
-        }
-
-        if (p.heading_valid) {
-
-            std::vector<oat::UnitVector2D> in_heading;
-            std::vector<oat::UnitVector2D> out_heading;
-            cv::Matx33d head_inv_homo = inv_homo;
-            head_inv_homo(0, 2) = 0.0; // offsets do not apply to heading
-            head_inv_homo(1, 2) = 0.0; // offsets do not apply to heading
-            in_heading.push_back(p.heading);
-            cv::perspectiveTransform(in_heading, out_heading, head_inv_homo);
-            cv::normalize(out_heading, out_heading);
-            p.heading = out_heading[0];
-        }
-    }
+    if (p.position_valid)
+        oat::applyHomography(inverse(p.homography()), p);
 }
 
 void Decorator::drawPosition()
@@ -304,7 +273,7 @@ void Decorator::drawPosition()
     for (auto &p : positions_) {
 
         if (p.unit_of_length() == oat::DistanceUnit::WORLD)
-            invertHomography(p);
+            invertHomography(p, homography_inverses_[i]);
 
         if (p.position_valid) {
 
@@ -29,6 +29,7 @@
 #include "../../lib/base/Configurable.h"
 #include "../../lib/base/ControllableComponent.h"
 #include "../../lib/datatypes/Frame.h"
+#include "../../lib/datatypes/Homography.h"
 #include "../../lib/datatypes/Position2D.h"
 #include "../../lib/shmemdf/Helpers.h"
 #include "../../lib/shmemdf/Sink.h"
@@ -134,12 +135,17 @@ private:
     // Sample number encoding
     int encode_bit_size_ {5};
 
+    // Inverse homography of each position source
+    std::vector<oat::HomographyInverse> homography_inverses_;
+
     /**
      * Project Positions into oat::PIXEL coordinates.
      * @param pos Position with unit_of_length != oat::PIXEL to be converted to
      * unit_of_length == oat::PIXEL.
+     * @param inverse Cached inverse of the position source's homography.
      */
-    void invertHomography(oat::Position2D &pos);
+    void invertHomography(oat::Position2D &pos,
+                          oat::HomographyInverse &inverse);
 
     // Frame mutating subroutines
     void drawPosition(void);
@@ -19,6 +19,7 @@
 
 #include "BackgroundSubtractor.h"
 
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <cpptoml.h>
@@ -27,7 +28,9 @@
 #include <opencv2/imgproc.hpp>
 
 #include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/ParallelRows.h"
 #include "../../lib/utility/ProgramOptions.h"
+#include "../../lib/utility/RunningAverage.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -54,6 +57,8 @@ po::options_description BackgroundSubtractor::options() const
          "first frame is used as the background image.")
         ;
 
+    appendThreadOptions(local_opts);
+
     return local_opts;
 }
 
@@ -65,22 +70,26 @@ void BackgroundSubtractor::applyConfiguration(const po::variables_map &vm,
     if (oat::config::getValue(vm, config_table, "background", img_path)) {
 
         // TODO: Color image only?
-        background_frame_ = cv::imread(img_path, CV_LOAD_IMAGE_COLOR);
+        cv::Mat background = cv::imread(img_path, CV_LOAD_IMAGE_COLOR);
 
-        if (background_frame_.data == nullptr)
+        if (background.data == nullptr)
             throw (std::runtime_error("File \"" + img_path + "\" could not be read."));
 
-        background_set_ = true;
+        setBackgroundImage(background);
     }
 
     // Adaptation coefficient
     oat::config::getNumericValue<double>(vm, config_table, "adaptation-coeff", alpha_, 0.0, 1.0);
+    alpha_q15_ = runningAverageRate(alpha_);
+
+    // Worker threads
+    applyThreadConfiguration(vm, config_table);
 }
 
 void BackgroundSubtractor::setBackgroundImage(const cv::Mat &frame)
 {
     background_frame_ = frame.clone();
-    frame.clone().convertTo(background_frame_f_, CV_32F);
+    background_frame_.convertTo(background_q8_, CV_16U, 256.0);
     background_set_ = true;
 }
 
@@ -91,12 +100,25 @@ void BackgroundSubtractor::filter(cv::Mat &frame)
     if (!background_set_)
         setBackgroundImage(frame);
 
-    if (alpha_ > 0.0) {
-       cv::accumulateWeighted(frame, background_frame_f_, alpha_);
-       background_frame_f_.convertTo(background_frame_, CV_8U);
+    // Checked here so that a mismatch throws on the calling thread instead
+    // of inside a worker, or overruns the accumulator
+    if (frame.size() != background_frame_.size()
+        || frame.type() != background_frame_.type())
+        throw std::runtime_error("Background image and frames must have the "
+                                 "same dimensions and color.");
+
+    // Static background: plain saturating subtraction, in place
+    if (alpha_q15_ == 0) {
+        parallelRows(frame.rows, [&](const cv::Range &rows) {
+            cv::Mat band = frame.rowRange(rows);
+            cv::subtract(band, background_frame_.rowRange(rows), band);
+        });
+        return;
     }
 
-    frame = frame - background_frame_;
+    // Adaptive background: update the running average, then subtract and
+    // saturate, in a single pass over the frame and the accumulator
+    subtractRunningAverage(frame, background_q8_, alpha_q15_);
 }
 
 } /* namespace oat */
@@ -47,12 +47,14 @@ private:
     // Is the background frame set?
     bool background_set_ {false};
 
-    // The background frame(s)
+    // The background frame and its Q8.8 fixed-point running average, which
+    // is used when the background adapts
     cv::Mat background_frame_;
-    cv::Mat background_frame_f_;
+    cv::Mat background_q8_;
 
-    // Background update rate
+    // Background update rate, and as Q0.15 fixed-point
     double alpha_ {0.0};
+    int32_t alpha_q15_ {0};
 
     /**
      * Apply background subtraction.
@@ -45,7 +45,8 @@ po::options_description ColorConvert::options() const
          "Values:\n"
          "  GREY: \t 8-bit Greyscale image.\n"
          "  BRG: \t8-bit, 3-chanel, BGR Color image.\n"
-         "  HSV: \t8-bit, 3-chanel, HSV Color image.\n")
+         "  HSV: \t8-bit, 3-chanel, HSV Color image.\n"
+         "Raw Bayer sources can be demosaiced to GREY or BGR.\n")
         ;
 
     return local_opts;
@@ -62,40 +63,26 @@ void ColorConvert::applyConfiguration(const po::variables_map &vm,
     }
 }
 
-bool ColorConvert::connectToNode()
+oat::FrameParams ColorConvert::sinkParameters(const oat::FrameParams &source)
 {
-    // Establish our a slot in the source node
-    frame_source_.touch(frame_source_address_);
-
-    // Wait for synchronous start with sink when it binds its node
-    if (frame_source_.connect() != SourceState::CONNECTED)
-        return false;
-
-    // Get frame meta data to format sink
-    auto frame_parameters = frame_source_.parameters();
-
     // Get the color conversion code
-    conversion_code_ = oat::color_conv_code(frame_parameters.color, color_);
+    conversion_code_ = oat::color_conv_code(source.color, color_);
 
     // If there is no conversion being done, throw
     if (conversion_code_ == -1) {
-        throw std::runtime_error("Nothing to be done for " + color_str(frame_parameters.color)
+        throw std::runtime_error("Nothing to be done for " + color_str(source.color)
                                  + " to "
                                  + color_str(color_)
                                  + " conversion.");
     }
 
-    // Bind to sink node and create a shared frame
     // Because this changes the color, it might change the size and type of
     // frame
-    size_t bytes = frame_parameters.rows * frame_parameters.cols
-                   * oat::color_bytes(color_);
-    frame_sink_.bind(frame_sink_address_, bytes);
-    shared_frame_ = frame_sink_.retrieve(frame_parameters.rows,
-                                         frame_parameters.cols,
-                                         oat::cv_type(color_),
-                                         color_);
-    return true;
+    auto sink = source;
+    sink.type = oat::cv_type(color_);
+    sink.color = color_;
+
+    return sink;
 }
 
 void ColorConvert::filter(cv::Mat &frame)
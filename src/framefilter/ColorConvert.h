@@ -40,11 +40,11 @@ public:
                  const std::string &frame_sink_address);
 
 private:
-    bool connectToNode(void) override;
     po::options_description options() const override;
     void applyConfiguration(const po::variables_map &vm,
                             const config::OptionTable &config_table) override;
 
+    oat::FrameParams sinkParameters(const oat::FrameParams &source) override;
     void filter(cv::Mat &frame) override;
 
     int conversion_code_;
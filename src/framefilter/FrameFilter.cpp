@@ -44,14 +44,18 @@ bool FrameFilter::connectToNode()
         return false;
 
     // Get frame meta data to format sink
-    auto frame_parameters = frame_source_.parameters();
+    auto source_parameters = frame_source_.parameters();
+    auto sink_parameters = sinkParameters(source_parameters);
+    sink_parameters.bytes = sink_parameters.rows * sink_parameters.cols
+                            * CV_ELEM_SIZE(sink_parameters.type);
 
     // Bind to sink node and create a shared frame
-    frame_sink_.bind(frame_sink_address_, frame_parameters.bytes);
-    shared_frame_ = frame_sink_.retrieve(frame_parameters.rows,
-                                         frame_parameters.cols,
-                                         frame_parameters.type,
-                                         frame_parameters.color);
+    frame_sink_.bind(frame_sink_address_, sink_parameters.bytes);
+    shared_frame_ = frame_sink_.retrieve(sink_parameters.rows,
+                                         sink_parameters.cols,
+                                         sink_parameters.type,
+                                         sink_parameters.color);
+    frame_sink_.set_roi(effectiveROI(source_parameters.roi));
 
     return true;
 }
@@ -67,8 +71,8 @@ int FrameFilter::process()
     if (frame_source_.wait() == oat::NodeState::END)
         return 1;
 
-    // Clone the shared frame
-    frame_source_.copyTo(internal_frame);
+    // Copy the shared frame
+    read(*frame_source_.retrieve(), internal_frame);
 
     // Tell sink it can continue
     frame_source_.post();
@@ -85,7 +89,7 @@ int FrameFilter::process()
     // Wait for sources to read
     frame_sink_.wait();
 
-    internal_frame.copyTo(shared_frame_);
+    write(internal_frame, shared_frame_);
 
     // Tell sources there is new data
     frame_sink_.post();
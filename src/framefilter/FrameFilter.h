@@ -25,18 +25,16 @@
 #include "../../lib/base/Configurable.h"
 #include "../../lib/base/ControllableComponent.h"
 #include "../../lib/datatypes/Frame.h"
+#include "../../lib/shmemdf/SharedFrameHeader.h"
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
 namespace oat {
 
-class ColorConvert; // Forward decl.
 namespace po = boost::program_options;
 
 class FrameFilter : public Component, public Configurable<false> {
 
-friend ColorConvert;
-
 public:
     /**
      * @brief Abstract frame filter.
@@ -56,16 +54,65 @@ protected:
     // Filter name
     const std::string name_;
 
+    /**
+     * Format of filtered frames. Called once, when connecting to the source,
+     * so format dependent buffers can be allocated here. By default, filters
+     * do not change the size, type or color of frames.
+     * @param source Format of source frames
+     * @return Format of frames published to the sink. Byte count is ignored.
+     */
+    virtual oat::FrameParams sinkParameters(const oat::FrameParams &source)
+    {
+        return source;
+    }
+
+    /**
+     * Copy a frame out of the source node, which is locked for the duration
+     * of the call. Override to combine the copy with a conversion.
+     * @param shared Frame in the source node
+     * @param frame Frame to be filtered
+     */
+    virtual void read(const oat::Frame &shared, oat::Frame &frame)
+    {
+        shared.copyTo(frame);
+    }
+
     /**
      * Perform frame filtering. Override to implement filtering operation in
-     * derived classes.
+     * derived classes. By default, frames are passed through unchanged.
      * @param frame to be filtered
      */
-    virtual void filter(cv::Mat &frame) = 0;
+    virtual void filter(cv::Mat &) { }
+
+    /**
+     * Copy a filtered frame into the sink node, which is locked for the
+     * duration of the call. Override to write the result of filtering
+     * straight into shared memory.
+     * @param frame Filtered frame
+     * @param shared Frame in the sink node, formatted by sinkParameters()
+     */
+    virtual void write(const oat::Frame &frame, oat::Frame &shared)
+    {
+        frame.copyTo(shared);
+    }
+
+    /**
+     * Region of filtered frames that can contain non-zero pixels, which is
+     * advertised to downstream components. By default, filters do not move
+     * pixels, so the source's region is passed through.
+     * @param source_roi Region advertised by the frame source. Empty
+     * indicates the whole frame.
+     * @return Region advertised to frame sink. Empty indicates the whole
+     * frame.
+     */
+    virtual cv::Rect effectiveROI(const cv::Rect &source_roi) const
+    {
+        return source_roi;
+    }
 
 private:
     // Component Interface
-    virtual bool connectToNode(void) override;
+    bool connectToNode(void) override;
     int process(void) override;
 
     // Frame source
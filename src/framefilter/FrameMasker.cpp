@@ -49,6 +49,8 @@ po::options_description FrameMasker::options() const
          "have the same dimensions as frames from SOURCE.")
         ;
 
+    appendThreadOptions(local_opts);
+
     return local_opts;
 }
 
@@ -59,19 +61,42 @@ void FrameMasker::applyConfiguration(const po::variables_map &vm,
     std::string img_path;
     if (oat::config::getValue(vm, config_table, "mask", img_path, true)) {
 
-        roi_mask_ = cv::imread(img_path, CV_LOAD_IMAGE_GRAYSCALE);
+        cv::Mat roi_mask = cv::imread(img_path, CV_LOAD_IMAGE_GRAYSCALE);
 
-        if (roi_mask_.data == NULL)
+        if (roi_mask.data == NULL)
             throw (std::runtime_error("File \"" + img_path + "\" could not be read."));
 
+        // The mask is static, so convert it to spans once
+        mask_.build(roi_mask);
         mask_set_ = true;
     }
+
+    // Worker threads
+    applyThreadConfiguration(vm, config_table);
 }
 
 void FrameMasker::filter(cv::Mat &frame)
 {
-    if (mask_set_)
-        frame.setTo(0, roi_mask_ == 0);
+    if (!mask_set_)
+        return;
+
+    if (frame.size() != mask_.size())
+        throw std::runtime_error("Mask and frame dimensions must match.");
+
+    mask_.apply(frame);
+}
+
+cv::Rect FrameMasker::effectiveROI(const cv::Rect &source_roi) const
+{
+    // Non-rectangular masks cannot be summarized by a region
+    const cv::Rect box = mask_.box();
+    if (box.area() == 0)
+        return source_roi;
+
+    if (source_roi.area() == 0)
+        return box;
+
+    return box & source_roi;
 }
 
 } /* namespace oat */
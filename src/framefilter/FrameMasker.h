@@ -22,6 +22,8 @@
 
 #include "FrameFilter.h"
 
+#include "../../lib/utility/MaskSpans.h"
+
 namespace oat {
 
 class FrameMasker : public FrameFilter {
@@ -46,10 +48,11 @@ private:
                             const config::OptionTable &config_table) override;
 
     void filter(cv::Mat& frame) override;
+    cv::Rect effectiveROI(const cv::Rect &source_roi) const override;
 
     // Mask frames with an arbitrary ROI
     bool mask_set_ = false;
-    cv::Mat roi_mask_;
+    oat::MaskSpans mask_;
 };
 
 }      /* namespace oat */
@@ -0,0 +1,206 @@
+//******************************************************************************
+//* File:   MotionEnergy.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include "MotionEnergy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/video/tracking.hpp>
+#include <cpptoml.h>
+
+#include "../../lib/utility/TOMLSanitize.h"
+#include "../../lib/utility/IOFormat.h"
+
+namespace oat {
+
+MotionEnergy::MotionEnergy(const std::string &frame_source_address,
+                           const std::string &frame_sink_address)
+: FrameFilter(frame_source_address, frame_sink_address)
+{
+    // Nothing
+}
+
+po::options_description MotionEnergy::options() const
+{
+    // Update CLI options
+    po::options_description local_opts;
+    local_opts.add_options()
+        ("levels,l", po::value<int>(),
+         "Number of image pyramid levels, 0 to 8, below the source "
+         "resolution at which motion is measured. Each level halves the "
+         "width and height of published frames. Defaults to 2.")
+        ("decay,d", po::value<double>(),
+         "Scalar value, 0 to 1.0, specifying the weight of previous motion "
+         "energy in the running average. Default is 0, specifying that only "
+         "the difference between the current and previous frame is used.")
+        ("flow,f",
+         "If true, measure sparse optical flow on a regular grid and mark each "
+         "grid cell with the flow magnitude if it exceeds the frame "
+         "difference energy.")
+        ("grid-step,g", po::value<int>(),
+         "Spacing, in published frame pixels, of the optical flow grid. "
+         "Defaults to 8.")
+        ("flow-gain,G", po::value<double>(),
+         "Motion energy per pixel of optical flow per frame. Defaults to 16.")
+        ;
+
+    return local_opts;
+}
+
+void MotionEnergy::applyConfiguration(const po::variables_map &vm,
+                                      const config::OptionTable &config_table)
+{
+    // Pyramid levels
+    oat::config::getNumericValue<int>(vm, config_table, "levels", levels_, 0, 8);
+
+    // Running average
+    oat::config::getNumericValue<double>(vm, config_table, "decay", decay_, 0.0, 1.0);
+
+    // Optical flow
+    oat::config::getValue<bool>(vm, config_table, "flow", flow_on_);
+    oat::config::getNumericValue<int>(vm, config_table, "grid-step", grid_step_, 1);
+    oat::config::getNumericValue<double>(vm, config_table, "flow-gain", flow_gain_, 0.0);
+}
+
+oat::FrameParams MotionEnergy::sinkParameters(const oat::FrameParams &source)
+{
+    // Motion is measured on intensity. Throws if the conversion is not
+    // possible.
+    conversion_code_ = oat::color_conv_code(source.color, PIX_GREY);
+
+    // All buffers are allocated once, here
+    cv::Size size(source.cols, source.rows);
+    grey_.create(size, CV_8UC1);
+
+    // Intermediate levels. The lowest level is held in low_.
+    pyramid_.resize(std::max(levels_ - 1, 0));
+    for (int i = 0; i < levels_; i++) {
+        size = cv::Size((size.width + 1) / 2, (size.height + 1) / 2);
+        if (i < levels_ - 1)
+            pyramid_[i].create(size, CV_8UC1);
+    }
+
+    low_[0].create(size, CV_8UC1);
+    low_[1].create(size, CV_8UC1);
+    diff_.create(size, CV_8UC1);
+    motion_.create(size, CV_8UC1);
+    energy_ = cv::Mat::zeros(size, CV_32FC1);
+
+    grid_.clear();
+    for (int y = grid_step_ / 2; y < size.height; y += grid_step_)
+        for (int x = grid_step_ / 2; x < size.width; x += grid_step_)
+            grid_.emplace_back(x, y);
+
+    auto sink = source;
+    sink.rows = size.height;
+    sink.cols = size.width;
+    sink.type = CV_8UC1;
+    sink.color = PIX_GREY;
+
+    return sink;
+}
+
+void MotionEnergy::read(const oat::Frame &shared, oat::Frame &frame)
+{
+    // Greyscale conversion doubles as the copy out of shmem
+    if (conversion_code_ >= 0)
+        cv::cvtColor(shared, grey_, conversion_code_);
+    else
+        static_cast<const cv::Mat &>(shared).copyTo(grey_);
+
+    frame.set_sample(shared.sample());
+    frame.set_color(PIX_GREY);
+}
+
+void MotionEnergy::filter(cv::Mat &frame)
+{
+    // Energy is computed from grey_, which was filled by read(). The
+    // published frame just refers to the result.
+    computeEnergy(motion_);
+    frame = motion_;
+}
+
+void MotionEnergy::computeEnergy(cv::Mat &out)
+{
+    cv::Mat &now = low_[current_];
+    const cv::Mat &before = low_[1 - current_];
+
+    // Pyramid levels are preallocated, so pyrDown does not allocate
+    cv::Mat src = grey_;
+    for (int i = 0; i < levels_; i++) {
+        cv::Mat &dst = i == levels_ - 1 ? now : pyramid_[i];
+        cv::pyrDown(src, dst, dst.size());
+        src = dst;
+    }
+
+    if (levels_ == 0)
+        grey_.copyTo(now);
+
+    if (have_previous_) {
+
+        // energy = decay * energy + (1 - decay) * |now - before|
+        cv::absdiff(now, before, diff_);
+        cv::accumulateWeighted(diff_, energy_, 1.0 - decay_);
+        energy_.convertTo(out, CV_8U);
+
+        if (flow_on_ && !grid_.empty()) {
+
+            cv::calcOpticalFlowPyrLK(before,
+                                     now,
+                                     grid_,
+                                     flowed_,
+                                     status_,
+                                     error_,
+                                     cv::Size(2 * grid_step_ + 1,
+                                              2 * grid_step_ + 1),
+                                     0);
+
+            const cv::Rect frame_rect(0, 0, out.cols, out.rows);
+            for (size_t i = 0; i < grid_.size(); i++) {
+
+                if (!status_[i])
+                    continue;
+
+                const cv::Point2f d = flowed_[i] - grid_[i];
+                const auto e = cv::saturate_cast<uchar>(
+                    flow_gain_ * std::sqrt(d.x * d.x + d.y * d.y));
+
+                const cv::Rect cell(grid_[i].x - grid_step_ / 2,
+                                    grid_[i].y - grid_step_ / 2,
+                                    grid_step_,
+                                    grid_step_);
+                cv::Mat c = out(cell & frame_rect);
+                cv::max(c, cv::Scalar(e), c);
+            }
+        }
+
+    } else {
+        out.setTo(0);
+        have_previous_ = true;
+    }
+
+    // Ping-pong
+    current_ = 1 - current_;
+}
+
+} /* namespace oat */
@@ -0,0 +1,99 @@
+//******************************************************************************
+//* File:   MotionEnergy.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_MOTIONENERGY_H
+#define	OAT_MOTIONENERGY_H
+
+#include "FrameFilter.h"
+
+#include <vector>
+#include <opencv2/core/mat.hpp>
+
+namespace oat {
+
+/**
+ * Low resolution motion energy.
+ */
+class MotionEnergy : public FrameFilter {
+public:
+
+    /**
+     * @brief Motion energy filter. Frames are reduced to a low resolution
+     * greyscale image pyramid level and compared to the previous frame's. The
+     * published frame is a running average of the absolute difference
+     * between levels, optionally combined with the magnitude of sparse
+     * optical flow measured on a grid. Published frames are 4^levels times
+     * smaller than source frames.
+     *
+     * @param frame_source_address raw frame source address
+     * @param frame_sink_address motion energy frame sink address
+     */
+    MotionEnergy(const std::string &frame_source_address,
+                 const std::string &frame_sink_address);
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    // Frame filter hooks. Published frames are smaller than, and may differ
+    // in color from, source frames.
+    oat::FrameParams sinkParameters(const oat::FrameParams &source) override;
+    void read(const oat::Frame &shared, oat::Frame &frame) override;
+    void filter(cv::Mat &frame) override;
+
+    // Pixels are scaled, so source ROI does not apply
+    cv::Rect effectiveROI(const cv::Rect &) const override { return cv::Rect(); }
+
+    // Number of pyramid levels below the source resolution
+    int levels_ {2};
+
+    // Running average coefficient of previous energy, 0 to 1
+    double decay_ {0.0};
+
+    // Sparse optical flow
+    bool flow_on_ {false};
+    int grid_step_ {8};
+    double flow_gain_ {16.0};
+    std::vector<cv::Point2f> grid_, flowed_;
+    std::vector<uchar> status_;
+    std::vector<float> error_;
+
+    // Source to greyscale conversion code (-1 = No conversion needed)
+    int conversion_code_ {-1};
+
+    // Preallocated buffers. The lowest pyramid level is ping-ponged between
+    // frames instead of copied.
+    cv::Mat grey_;
+    std::vector<cv::Mat> pyramid_;
+    cv::Mat low_[2];
+    int current_ {0};
+    bool have_previous_ {false};
+    cv::Mat diff_, energy_, motion_;
+
+    /**
+     * Compute motion energy for the greyscale frame in grey_.
+     * @param out Motion energy frame.
+     */
+    void computeEnergy(cv::Mat &out);
+};
+
+}      /* namespace oat */
+#endif /* OAT_MOTIONENERGY_H */
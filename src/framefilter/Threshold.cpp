@@ -24,6 +24,7 @@
 #include <string>
 
 #include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/ParallelRows.h"
 #include "../../lib/utility/ProgramOptions.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
@@ -46,6 +47,8 @@ po::options_description Threshold::options() const
          "intensity passband.")
         ;
 
+    appendThreadOptions(local_opts);
+
     return local_opts;
 }
 
@@ -62,22 +65,29 @@ void Threshold::applyConfiguration(const po::variables_map &vm,
         if (i_min_ < 0 || i_min_> 256 || i_max_ < 0 || i_max_ > 256)
            throw std::runtime_error("Values of intensity should be between 0 and 256.");
     }
+
+    // Worker threads
+    applyThreadConfiguration(vm, config_table);
 }
 
 void Threshold::filter(cv::Mat &frame)
 {
-    cv::Mat grey_frame, thresh_frame;
-
     auto conversion_code = oat::color_conv_code(
         static_cast<oat::Frame &>(frame).color(), oat::PIX_GREY);
 
-    if (conversion_code >= 0)
-        cv::cvtColor(frame, grey_frame, conversion_code);
-    else
-        grey_frame = frame;
+    parallelRows(frame.rows, [&](const cv::Range &rows) {
+
+        cv::Mat band = frame.rowRange(rows);
+        cv::Mat grey_band, thresh_band;
+
+        if (conversion_code >= 0)
+            cv::cvtColor(band, grey_band, conversion_code);
+        else
+            grey_band = band;
 
-    cv::inRange(grey_frame, i_min_, i_max_, thresh_frame);
-    frame.setTo(cv::Scalar(0, 0, 0), thresh_frame == 0);
+        cv::inRange(grey_band, i_min_, i_max_, thresh_band);
+        band.setTo(cv::Scalar(0, 0, 0), thresh_band == 0);
+    });
 }
 
 } /* namespace oat */
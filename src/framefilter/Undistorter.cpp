@@ -22,12 +22,12 @@
 #include <string>
 
 #include <opencv2/core.hpp>
-#include <opencv2/imgproc.hpp>
-#include <opencv2/calib3d.hpp>
 #include <cpptoml.h>
 
 #include "../../lib/utility/TOMLSanitize.h"
 #include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/ParallelRows.h"
+#include "../../lib/utility/Rectify.h"
 
 namespace oat {
 
@@ -51,6 +51,8 @@ po::options_description Undistorter::options() const
          "distortion coefficients. Generated by oat-calibrate.")
         ;
 
+    appendThreadOptions(local_opts);
+
     return local_opts;
 }
 
@@ -78,13 +80,28 @@ void Undistorter::applyConfiguration(const po::variables_map &vm,
         camera_matrix_(2, 1) = K[7];
         camera_matrix_(2, 2) = K[8];
     }
+
+    // Worker threads
+    applyThreadConfiguration(vm, config_table);
+}
+
+oat::FrameParams Undistorter::sinkParameters(const oat::FrameParams &source)
+{
+    // Frame size is fixed from here on
+    buildRectifyMaps(camera_matrix_,
+                     dist_coeff_,
+                     cv::Size(source.cols, source.rows),
+                     map_xy_,
+                     map_interp_);
+
+    return source;
 }
 
-void Undistorter::filter(cv::Mat &frame)
+void Undistorter::write(const oat::Frame &frame, oat::Frame &shared)
 {
-    cv::Mat temp = frame.clone();
-    // TODO: too slow -- GPU implementation.
-    cv::undistort(temp, frame, camera_matrix_, dist_coeff_);
+    // Undistort straight into shmem
+    rectify(frame, shared, map_xy_, map_interp_);
+    shared.set_sample(frame.sample());
 }
 
 } /* namespace oat */
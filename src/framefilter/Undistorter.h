@@ -47,16 +47,25 @@ private:
     void applyConfiguration(const po::variables_map &vm,
                             const config::OptionTable &config_table) override;
 
+    // Builds rectification maps for the source frame size
+    oat::FrameParams sinkParameters(const oat::FrameParams &source) override;
+
     /**
-     * Apply undistortion filter.
+     * Apply undistortion filter straight into the sink's shared frame.
      * @param frame Unfiltered frame
-     * @return Filtered frame
+     * @param shared Filtered frame
      */
-    void filter(cv::Mat &frame) override;
+    void write(const oat::Frame &frame, oat::Frame &shared) override;
+
+    // Pixels are moved, so source ROI does not apply
+    cv::Rect effectiveROI(const cv::Rect &) const override { return cv::Rect(); }
 
     cv::Matx33d camera_matrix_ {cv::Matx33d::eye()};
     std::vector<double> dist_coeff_;
 
+    // Fixed-point rectification maps, built once at connection
+    cv::Mat map_xy_, map_interp_;
+
     static const std::map<std::string, int> commands_;
 };
 
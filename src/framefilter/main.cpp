@@ -36,6 +36,7 @@
 #include "ColorConvert.h"
 #include "FrameFilter.h"
 #include "FrameMasker.h"
+#include "MotionEnergy.h"
 #include "Undistorter.h"
 #include "Threshold.h"
 
@@ -49,6 +50,7 @@ const char usage_type[] =
     "  col: Color conversion\n"
     "  mask: Binary mask\n"
     "  mog: Mixture of Gaussians background segmentation.\n"
+    "  motion: Low resolution motion energy.\n"
     "  undistort: Correct for lens distortion using lens distortion model.\n"
     "  thresh: Simple intensity threshold.";
 
@@ -103,6 +105,7 @@ int main(int argc, char *argv[]) {
     type_hash["undistort"] = 'd';
     type_hash["col"] = 'e';
     type_hash["thresh"] = 'f';
+    type_hash["motion"] = 'g';
 
     // The component itself
     std::string comp_name = "framefilt";
@@ -191,6 +194,11 @@ int main(int argc, char *argv[]) {
                     filter = std::make_shared<oat::Threshold>(source, sink);
                     break;
                 }
+                case 'g':
+                {
+                    filter = std::make_shared<oat::MotionEnergy>(source, sink);
+                    break;
+                }
                 default:
                 {
                     printUsage(visible_options, "");
@@ -43,6 +43,14 @@ po::options_description FileReader::options() const
          "Path to video file to serve frames from.")
         ("fps,r", po::value<double>(),
          "Frames to serve per second.")
+        ("color,C", po::value<std::string>(),
+         "Pixel color format. Frames are converted from BGR as they are "
+         "copied into shared memory, so a separate color conversion stage is "
+         "not required. Defaults to BGR.\n"
+         "Values:\n"
+         "  GREY: \t 8-bit Greyscale image.\n"
+         "  BGR: \t8-bit, 3-chanel, BGR Color image.\n"
+         "  HSV: \t8-bit, 3-chanel, HSV Color image.\n")
         ("roi", po::value<std::string>(),
          "Four element array of unsigned ints, [x0,y0,width,height],"
          "defining a rectangular region of interest. Origin"
@@ -65,6 +73,15 @@ void FileReader::applyConfiguration(const po::variables_map &vm,
     if (oat::config::getNumericValue(vm, config_table, "fps", frames_per_second_, 0.0))
         calculateFramePeriod();
 
+    // Pixel color
+    std::string col;
+    if (oat::config::getValue<std::string>(vm, config_table, "color", col)) {
+        if (oat::is_bayer(oat::str_color(col)))
+            throw std::runtime_error("Decoded video files cannot be served "
+                                     "as raw Bayer frames.");
+        set_color(oat::str_color(col));
+    }
+
     // ROI
     std::vector<size_t> roi;
     if (oat::config::getArray<size_t, 4>(vm, config_table, "roi", roi)) {
@@ -86,10 +103,10 @@ bool FileReader::connectToNode()
         example_frame = example_frame(region_of_interest_);
 
     frame_sink_.bind(frame_sink_address_,
-            example_frame.total() * example_frame.elemSize());
+            example_frame.total() * oat::color_bytes(color_));
 
     shared_frame_ = frame_sink_.retrieve(
-            example_frame.rows, example_frame.cols, example_frame.type(), PIX_BGR);
+            example_frame.rows, example_frame.cols, oat::cv_type(color_), color_);
 
     // Reset the video to the start
     file_reader_.set(cv::CAP_PROP_POS_AVI_RATIO, 0);
@@ -106,16 +123,14 @@ int FileReader::process()
     if (!file_reader_.read(frame)) 
         return 1;
 
-    if (use_roi_ )
-        frame = frame(region_of_interest_);
-
     // START CRITICAL SECTION //
     ////////////////////////////
 
     // Wait for sources to read
     frame_sink_.wait();
 
-    frame.copyTo(shared_frame_);
+    // Crop and color convert directly into shmem
+    writeSharedFrame(frame);
     shared_frame_.incrementSampleCount();
 
     // Tell sources there is new data
@@ -52,9 +52,6 @@ private:
     double frames_per_second_;
     void calculateFramePeriod(void);
 
-    // Region of interest
-    cv::Rect_<size_t> region_of_interest_;
-
     // Frame generation clock
     std::chrono::high_resolution_clock clock_;
     std::chrono::duration<double> frame_period_in_sec_;
@@ -21,6 +21,8 @@
 
 #include <string>
 
+#include <opencv2/imgproc.hpp>
+
 namespace oat {
 
 FrameServer::FrameServer(const std::string &frame_sink_address) :
@@ -29,4 +31,35 @@ FrameServer::FrameServer(const std::string &frame_sink_address) :
 {
     // Nothing
 }
+
+void FrameServer::set_color(const oat::PixelColor col)
+{
+    if (col == oat::PIX_BINARY)
+        throw std::runtime_error("Frames cannot be served as BINARY.");
+
+    // Raw Bayer mosaics are served as-is. Consumers demosaic them.
+    if (oat::is_bayer(col)) {
+        conversion_code_ = -1;
+        color_ = col;
+        return;
+    }
+
+    // Throws if the conversion is not possible
+    conversion_code_ = oat::color_conv_code(oat::PIX_BGR, col);
+    color_ = col;
+}
+
+void FrameServer::writeSharedFrame(const cv::Mat &raw)
+{
+    // Non-contiguous view, no copy
+    const cv::Mat src = use_roi_ ? raw(region_of_interest_) : raw;
+
+    // shared_frame_ already has the correct size and type, so neither of
+    // these will reallocate: results are written straight into shmem
+    if (conversion_code_ >= 0)
+        cv::cvtColor(src, shared_frame_, conversion_code_);
+    else
+        src.copyTo(shared_frame_);
+}
+
 } /* namespace oat */
@@ -55,6 +55,27 @@ protected:
     bool use_roi_ {false};
     cv::Rect_<size_t> region_of_interest_;
 
+    // Pixel color of served frames
+    oat::PixelColor color_ {oat::PIX_BGR};
+
+    /**
+     * @brief Set the pixel color of served frames. Raw frames are assumed to
+     * be BGR and must be convertible to the requested color, unless a Bayer
+     * color is requested, in which case raw frames must be single channel
+     * mosaics and are passed through unconverted.
+     * @param col Served pixel color.
+     */
+    void set_color(const oat::PixelColor col);
+
+    /**
+     * @brief Crop a raw BGR frame to the region of interest, if one is
+     * specified, and convert it to the served pixel color. The crop and color
+     * conversion are performed in a single pass that writes directly into the
+     * shared frame so that no intermediate copy is made.
+     * @param raw Raw BGR frame from the device.
+     */
+    void writeSharedFrame(const cv::Mat &raw);
+
     // Frame sink
     const std::string frame_sink_address_;
     oat::Sink<oat::Frame> frame_sink_;
@@ -62,6 +83,10 @@ protected:
     // Currently acquired, shared frame
     //bool frame_empty_ {true};
     oat::Frame shared_frame_;
+
+private:
+    // BGR to color_ conversion code (-1 = No conversion needed)
+    int conversion_code_ {-1};
 };
 
 }       /* namespace oat */
@@ -47,7 +47,16 @@ const typename PointGreyCam<T>::PixelMap PointGreyCam<T>::pix_map_ =
     {PIX_GREY,
         std::make_tuple(pg::PIXEL_FORMAT_MONO8, pg::PIXEL_FORMAT_MONO8, CV_8UC1)},
     {PIX_BGR,
-        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_BGR, CV_8UC3)}
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_BGR, CV_8UC3)},
+    // Raw sensor mosaics are served as-is and demosaiced by consumers
+    {PIX_BAYER_RGGB,
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_RAW8, CV_8UC1)},
+    {PIX_BAYER_GRBG,
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_RAW8, CV_8UC1)},
+    {PIX_BAYER_GBRG,
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_RAW8, CV_8UC1)},
+    {PIX_BAYER_BGGR,
+        std::make_tuple(pg::PIXEL_FORMAT_RAW8, pg::PIXEL_FORMAT_RAW8, CV_8UC1)}
 };
 
 template <typename T>
@@ -91,7 +100,11 @@ po::options_description PointGreyCam<T>::options() const
          "Pixel color format. Defaults to BRG.\n"
          "Values:\n"
          "  GREY: \t 8-bit Greyscale image.\n"
-         "  BRG: \t8-bit, 3-chanel, BGR Color image.\n")
+         "  BRG: \t8-bit, 3-chanel, BGR Color image.\n"
+         "  BAYER_RGGB, BAYER_GRBG, BAYER_GBRG, BAYER_BGGR: \t8-bit, raw "
+         "sensor mosaic. Demosaicing is deferred to downstream components, "
+         "which reduces the bandwidth of this server by 3x. Pattern must "
+         "match the sensor's.\n")
         ("gain,g", po::value<double>(),
          "Sensor gain value, specified in dB. Defaults to auto.")
         ("strobe-pin,S", po::value<size_t>(),
@@ -60,9 +60,6 @@ private:
 
     // Sample count specification
     uint64_t num_samples_ {std::numeric_limits<int64_t>::max()};
-
-    // Color switch
-    oat::PixelColor color_ {oat::PIX_BGR};
 };
 
 }       /* namespace oat */
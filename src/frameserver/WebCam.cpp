@@ -23,6 +23,7 @@
 #include <string>
 #include <opencv2/core/mat.hpp>
 
+#include "../../lib/datatypes/Demosaic.h"
 #include "../../lib/utility/TOMLSanitize.h"
 #include "../../lib/utility/IOFormat.h"
 #include "../../lib/utility/make_unique.h"
@@ -45,6 +46,17 @@ po::options_description WebCam::options() const
          "configurations. Defaults to 0.")
         ("fps,r", po::value<double>(),
          "Frames to serve per second. Defaults to 20.")
+        ("color,C", po::value<std::string>(),
+         "Pixel color format. Frames are converted from BGR as they are "
+         "copied into shared memory, so a separate color conversion stage is "
+         "not required. Defaults to BGR.\n"
+         "Values:\n"
+         "  GREY: \t 8-bit Greyscale image.\n"
+         "  BGR: \t8-bit, 3-chanel, BGR Color image.\n"
+         "  HSV: \t8-bit, 3-chanel, HSV Color image.\n"
+         "  BAYER_RGGB, BAYER_GRBG, BAYER_GBRG, BAYER_BGGR: \t8-bit, raw "
+         "sensor mosaic. Requires a device that can provide unconverted "
+         "frames. Demosaicing is deferred to downstream components.\n")
         ("roi", po::value<std::string>(),
          "Four element array of unsigned ints, [x0,y0,width,height],"
          "defining a rectangular region of interest. Origin"
@@ -75,6 +87,15 @@ void WebCam::applyConfiguration(const po::variables_map &vm,
             std::cerr << oat::Warn("Not able to set webcam mat rate.\n");
     }
 
+    // Pixel color
+    std::string col;
+    if (oat::config::getValue<std::string>(vm, config_table, "color", col))
+        set_color(oat::str_color(col));
+
+    // Ask the backend for unconverted sensor data
+    if (oat::is_bayer(color_))
+        cv_camera_->set(cv::CAP_PROP_CONVERT_RGB, 0);
+
     // ROI
     std::vector<size_t> roi;
     if (oat::config::getArray<size_t, 4>(vm, config_table, "roi", roi)) {
@@ -91,14 +112,26 @@ bool WebCam::connectToNode()
     cv::Mat example_frame;
     *cv_camera_ >> example_frame;
 
+    if (oat::is_bayer(color_)) {
+
+        if (example_frame.type() != CV_8UC1)
+            throw std::runtime_error("Webcam " + std::to_string(index_)
+                                     + " does not provide raw Bayer frames.");
+
+        // Cropping an odd number of rows or columns shifts the mosaic
+        if (use_roi_)
+            color_ = oat::bayer_shift(
+                color_, region_of_interest_.x, region_of_interest_.y);
+    }
+
     if (use_roi_)
         example_frame = example_frame(region_of_interest_);
 
     frame_sink_.bind(frame_sink_address_,
-                     example_frame.total() * oat::color_bytes(oat::PIX_BGR));
+                     example_frame.total() * oat::color_bytes(color_));
 
     shared_frame_ = frame_sink_.retrieve(
-        example_frame.rows, example_frame.cols, example_frame.type(), oat::PIX_BGR);
+        example_frame.rows, example_frame.cols, oat::cv_type(color_), color_);
 
     // Put the sample rate in the shared mat
     shared_frame_.set_rate_hz(cv_camera_->get(cv::CAP_PROP_FPS));
@@ -114,9 +147,6 @@ int WebCam::process()
     if (!cv_camera_->read(mat)) 
         return 1;
 
-    if (use_roi_ )
-        mat = mat(region_of_interest_);
-
     if (first_frame_) 
         start_ = clock_.now();
 
@@ -138,7 +168,8 @@ int WebCam::process()
         shared_frame_.incrementSampleCount(time_since_start);
     }
 
-    mat.copyTo(shared_frame_);
+    // Crop and color convert directly into shmem
+    writeSharedFrame(mat);
 
     // Tell sources there is new data
     frame_sink_.post();
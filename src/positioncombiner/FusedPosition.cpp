@@ -0,0 +1,181 @@
+//******************************************************************************
+//* File:   FusedPosition.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cpptoml.h>
+
+#include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/TOMLSanitize.h"
+
+#include "FusedPosition.h"
+
+namespace oat {
+
+po::options_description FusedPosition::options() const
+{
+    // Update CLI options
+    po::options_description local_opts;
+    local_opts.add_options()
+        ("variance", po::value<std::string>(),
+         "Array of positive values, one per SOURCE, [v0,v1,...], specifying "
+         "the measurement noise variance of each SOURCE position in squared "
+         "units of length. Lower variance gives a SOURCE more weight. Defaults "
+         "to 1 for every SOURCE. When variances are adapted, these are the "
+         "initial values.")
+        ("adapt-rate", po::value<double>(),
+         "Value in [0 1) specifying the rate at which each SOURCE's variance "
+         "is re-estimated from its disagreement with the other SOURCES. 0 "
+         "keeps the variances fixed. Requires at least three SOURCES: with "
+         "two, only the sum of their variances can be estimated from their "
+         "disagreement, not how it splits between them. Defaults to 0.")
+        ("min-variance", po::value<double>(),
+         "Lower bound on adapted variances. Defaults to 0.01.")
+        ;
+
+    appendSyncOptions(local_opts);
+
+    return local_opts;
+}
+
+void FusedPosition::applyConfiguration(const po::variables_map &vm,
+                                       const config::OptionTable &config_table)
+{
+    // Setup sources and sink
+    PositionCombiner::resolvePositionSources(vm);
+
+    // Measurement variances
+    variance_.assign(num_sources(), 1.0);
+    std::vector<double> var;
+    if (oat::config::getArray<double>(vm, config_table, "variance", var)) {
+
+        if (var.size() != variance_.size())
+            throw std::runtime_error(
+                "variance must contain one value per SOURCE.");
+
+        for (const auto &v : var)
+            if (!(v > 0))
+                throw std::runtime_error("variance values must be positive.");
+
+        variance_ = var;
+    }
+
+    // Adaptation
+    oat::config::getNumericValue<double>(
+        vm, config_table, "adapt-rate", adapt_rate_, 0.0, 0.999);
+
+    if (adapt_rate_ > 0 && num_sources() < 3)
+        throw std::runtime_error(
+            "adapt-rate requires at least three SOURCES.");
+    oat::config::getNumericValue<double>(
+        vm, config_table, "min-variance", min_variance_, 1e-12);
+
+    // Sample synchronization
+    applySyncConfiguration(vm, config_table);
+}
+
+void FusedPosition::combine(const std::vector<oat::Position2D> &sources,
+                            oat::Position2D &combined_position)
+{
+    // Information filter update with a flat prior: information adds across
+    // independent measurements
+    double info = 0.0, vel_info = 0.0, best_weight = 0.0;
+    oat::Point2D info_pos(0, 0);
+    oat::Velocity2D info_vel(0, 0);
+    oat::UnitVector2D heading(0, 0);
+    const oat::Position2D *best = nullptr;
+
+    for (size_t i = 0; i < sources.size(); i++) {
+
+        const auto &pos = sources[i];
+        const double w = 1.0 / variance_[i];
+
+        if (pos.position_valid) {
+            info += w;
+            info_pos += w * pos.position;
+
+            if (w > best_weight) {
+                best_weight = w;
+                best = &pos;
+            }
+        }
+
+        if (pos.velocity_valid) {
+            vel_info += w;
+            info_vel += w * pos.velocity;
+        }
+
+        if (pos.heading_valid)
+            heading += w * pos.heading;
+    }
+
+    combined_position.position_valid = info > 0;
+    if (combined_position.position_valid)
+        combined_position.position = info_pos / info;
+
+    combined_position.velocity_valid = vel_info > 0;
+    if (combined_position.velocity_valid)
+        combined_position.velocity = info_vel / vel_info;
+
+    // Renormalize head-direction unit vector
+    const double mag = std::sqrt(heading.x * heading.x + heading.y * heading.y);
+    combined_position.heading_valid = mag > 0;
+    if (combined_position.heading_valid)
+        combined_position.heading = heading / mag;
+
+    // Categorical position of the most trusted valid SOURCE
+    combined_position.region_valid = best != nullptr && best->region_valid;
+    if (combined_position.region_valid)
+        std::copy(best->region, best->region + Position2D::REGION_LEN,
+                  combined_position.region);
+
+    if (adapt_rate_ > 0)
+        adaptVariances(sources, info, info_pos);
+}
+
+void FusedPosition::adaptVariances(const std::vector<oat::Position2D> &sources,
+                                   const double info,
+                                   const oat::Point2D &info_pos)
+{
+    for (size_t i = 0; i < sources.size(); i++) {
+
+        if (!sources[i].position_valid)
+            continue;
+
+        // Fusion of the other SOURCES, which is independent of this one
+        const double w = 1.0 / variance_[i];
+        const double others_info = info - w;
+        if (!(others_info > 0))
+            continue;
+
+        const oat::Point2D others
+            = (info_pos - w * sources[i].position) / others_info;
+        const oat::Point2D e = sources[i].position - others;
+
+        // E[|e|^2] / 2 = variance_i + 1 / others_info for isotropic noise
+        const double v = 0.5 * e.dot(e) - 1.0 / others_info;
+        variance_[i] = std::max(
+            min_variance_, (1.0 - adapt_rate_) * variance_[i] + adapt_rate_ * v);
+    }
+}
+
+} /* namespace oat */
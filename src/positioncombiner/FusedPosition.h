@@ -0,0 +1,76 @@
+//******************************************************************************
+//* File:   FusedPosition.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+
+#ifndef OAT_FUSEDPOSITION_H
+#define	OAT_FUSEDPOSITION_H
+
+#include "PositionCombiner.h"
+
+#include <string>
+#include <vector>
+
+namespace oat {
+
+/**
+ * An inverse variance weighted position combiner.
+ * Fuses 2 or more source positions using an information filter update in
+ * which each SOURCE is a measurement with its own isotropic noise variance.
+ * Invalid SOURCES are left out of the update rather than invalidating the
+ * result. Variances can be fixed or adapted online from each SOURCE's
+ * residual with respect to the others.
+ */
+class FusedPosition : public PositionCombiner {
+
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    /**
+     * Calculate the inverse variance weighted mean of SOURCE positions.
+     * @param sources SOURCE positions to combine
+     * @param combined_position Combined position output
+     */
+    void combine(const std::vector<oat::Position2D> &source_positions,
+                 oat::Position2D &combined_position) override;
+
+    /**
+     * Update each valid SOURCE's noise variance estimate from its residual
+     * with respect to the fusion of all other valid SOURCES.
+     * @param sources SOURCE positions that were combined
+     * @param info Total information of the valid SOURCES
+     * @param info_pos Information weighted sum of the valid SOURCE positions
+     */
+    void adaptVariances(const std::vector<oat::Position2D> &sources,
+                        const double info,
+                        const oat::Point2D &info_pos);
+
+    /// Per-SOURCE running estimate of measurement noise variance
+    std::vector<double> variance_;
+
+    /// Floor on variance estimates so no SOURCE gets unbounded weight
+    double min_variance_ {1e-2};
+
+    /// Variance adaptation rate. 0 means fixed variances.
+    double adapt_rate_ {0.0};
+};
+
+}      /* namespace oat */
+#endif /* OAT_FUSEDPOSITION_H */
@@ -19,21 +19,28 @@
 
 #include "PositionCombiner.h"
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <vector>
 #include <utility>
-#include <thread>
-#include <future>
 
 #include "../../lib/datatypes/Position2D.h"
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 #include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/TOMLSanitize.h"
 #include "../../lib/utility/make_unique.h"
 
 namespace oat {
 
+// Minimum number of uncombined samples held per SOURCE, and the number held
+// beyond those that can arrive within the sync timeout
+static constexpr size_t SAMPLE_QUEUE_MIN_LEN {16};
+
+// Longest time to block on a single SOURCE before servicing the others
+static constexpr long SYNC_POLL_MSEC {1};
+
 void PositionCombiner::resolvePositionSources(const po::variables_map &vm)
 {
     // Pull the sources and sink out as positional options
@@ -61,6 +68,51 @@ void PositionCombiner::resolvePositionSources(const po::variables_map &vm)
     }
 }
 
+void PositionCombiner::appendSyncOptions(po::options_description &opts) const
+{
+    opts.add_options()
+        ("sync", po::value<std::string>(),
+         "Policy used to select the SOURCE samples that are combined. 'exact' "
+         "combines samples with the same sample count. 'nearest' combines the "
+         "first SOURCE's samples with each other SOURCE's sample that is "
+         "nearest in time. 'latest' combines the most recent sample from each "
+         "SOURCE each time any of them produces a new one. Defaults to "
+         "'exact'.")
+        ("sync-timeout", po::value<double>(),
+         "Seconds to wait for the samples to be combined to arrive before "
+         "combining without them. SOURCES whose sample is missing are "
+         "presented as invalid positions. Not used by the 'latest' policy. "
+         "Defaults to 0.1.")
+        ;
+}
+
+void PositionCombiner::applySyncConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    SyncPolicy policy = aligner_.policy();
+    std::string policy_name;
+    if (oat::config::getValue<std::string>(vm, config_table, "sync", policy_name)) {
+        if (policy_name == "exact")
+            policy = SyncPolicy::EXACT;
+        else if (policy_name == "nearest")
+            policy = SyncPolicy::NEAREST;
+        else if (policy_name == "latest")
+            policy = SyncPolicy::LATEST;
+        else
+            throw std::runtime_error(
+                "Sync policy must be 'exact', 'nearest', or 'latest'.");
+    }
+
+    auto timeout = aligner_.timeout();
+    double timeout_sec;
+    if (oat::config::getNumericValue<double>(
+            vm, config_table, "sync-timeout", timeout_sec, 0.0))
+        timeout = boost::posix_time::microseconds(
+            static_cast<long>(timeout_sec * 1e6));
+
+    aligner_.set_policy(policy, timeout);
+}
+
 bool PositionCombiner::connectToNode()
 {
     // Establish our slot in each node
@@ -85,26 +137,69 @@ bool PositionCombiner::connectToNode()
     position_sink_.bind(position_sink_address_, position_sink_address_);
     shared_position_ = position_sink_.retrieve();
 
+    // Queues for samples that have not been combined. Each must hold every
+    // sample its SOURCE can produce while another SOURCE is stalled for the
+    // sync timeout, or whole sample counts are dropped instead of combined
+    // late.
+    const double timeout_sec
+        = aligner_.timeout().total_microseconds() * 1.0e-6;
+    std::vector<size_t> capacities;
+    for (const auto ts : all_ts) {
+        size_t len = SAMPLE_QUEUE_MIN_LEN;
+        if (ts > 0)
+            len += static_cast<size_t>(std::ceil(timeout_sec / ts));
+        capacities.push_back(len);
+    }
+    aligner_.reset(capacities);
+
     return true;
 }
 
+void PositionCombiner::receive(const pvec_size_t idx,
+                               const boost::system_time &deadline)
+{
+    auto &source = position_sources_[idx].source;
+
+    // START CRITICAL SECTION //
+    ////////////////////////////
+    if (!source->waitUntil(deadline))
+        return;
+
+    if (source->sink_state() == oat::NodeState::END) {
+        sources_eof_ = true;
+        return;
+    }
+
+    aligner_.push(idx, *source->retrieve(), boost::get_system_time());
+
+    source->post();
+    ////////////////////////////
+    //  END CRITICAL SECTION  //
+}
+
 int PositionCombiner::process()
 {
-    for (pvec_size_t i = 0; i != position_sources_.size(); i++) {
+    // Read each SOURCE that has written without waiting for those that have
+    // not, so that a slow or stalled SOURCE does not hold up the others
+    const auto now = boost::get_system_time();
+    for (pvec_size_t i = 0; i != position_sources_.size(); i++)
+        receive(i, now);
+
+    if (sources_eof_)
+        return 1;
 
-        // START CRITICAL SECTION //
-        ////////////////////////////
-        if (position_sources_[i].source->wait() == oat::NodeState::END)
-            return 1;
+    if (!aligner_.align(boost::get_system_time(), positions_)) {
 
-        positions_[i] = position_sources_[i].source->clone();
+        // Block briefly on a SOURCE that the next combination needs instead
+        // of spinning
+        receive(aligner_.waiting_on(),
+                boost::get_system_time() + msec_t(SYNC_POLL_MSEC));
 
-        position_sources_[i].source->post();
-        ////////////////////////////
-        //  END CRITICAL SECTION  //
+        return sources_eof_ ? 1 : 0;
     }
 
     combine(positions_, internal_position_);
+    internal_position_.set_sample(positions_[aligner_.reference()].sample());
 
     // START CRITICAL SECTION //
     ////////////////////////////
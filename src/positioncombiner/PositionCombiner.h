@@ -26,6 +26,7 @@
 #include <utility>
 
 #include <boost/program_options.hpp>
+#include <boost/thread/thread_time.hpp>
 
 #include "../../lib/base/Component.h"
 #include "../../lib/base/Configurable.h"
@@ -34,6 +35,8 @@
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
+#include "SampleAligner.h"
+
 namespace po = boost::program_options;
 
 namespace oat {
@@ -59,6 +62,20 @@ protected:
      */
     void resolvePositionSources(const po::variables_map &vm);
 
+    /**
+     * @brief Append sample synchronization options.
+     * @param opts Options to append to.
+     */
+    void appendSyncOptions(po::options_description &opts) const;
+
+    /**
+     * @brief Apply sample synchronization options.
+     * @param vm Pre-parse program option map.
+     * @param config_table Parsed TOML options table.
+     */
+    void applySyncConfiguration(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
+
     /**
      * Perform position combination.
      * @param sources SOURCE position servers
@@ -78,6 +95,14 @@ private:
     virtual bool connectToNode(void) override;
     int process(void) override;
 
+    /**
+     * @brief Read a SOURCE's sample into its queue if the SOURCE has written
+     * by the deadline.
+     * @param idx SOURCE index.
+     * @param deadline Time at which to give up waiting.
+     */
+    void receive(const pvec_size_t idx, const boost::system_time &deadline);
+
     // Combiner name
     std::string name_;
 
@@ -85,6 +110,10 @@ private:
     std::vector<oat::Position2D> positions_;
     oat::NamedSourceList<oat::Position2D> position_sources_;
 
+    // Sample synchronization
+    oat::SampleAligner aligner_;
+    bool sources_eof_ {false};
+
     // Combined position
     oat::Position2D internal_position_ {"internal"};
 
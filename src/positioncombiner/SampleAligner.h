@@ -0,0 +1,372 @@
+//******************************************************************************
+//* File:   SampleAligner.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_SAMPLEALIGNER_H
+#define	OAT_SAMPLEALIGNER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <boost/thread/thread_time.hpp>
+
+#include "../../lib/datatypes/Position2D.h"
+
+namespace oat {
+
+/**
+ * Policy used to decide which SOURCE samples are combined.
+ */
+enum class SyncPolicy {
+    EXACT,      //!< Samples sharing a sample count
+    NEAREST,    //!< Samples nearest in time to the first SOURCE's sample
+    LATEST      //!< Most recent sample from each SOURCE
+};
+
+/**
+ * Queues samples received from each of a position combiner's SOURCES and
+ * selects the sets of samples that are combined according to a SyncPolicy.
+ * Holds no shared memory, so a slow or stalled SOURCE only delays, and does
+ * not block, the selection.
+ */
+class SampleAligner {
+
+public:
+    /**
+     * @brief Set the number of SOURCES and their queue capacities. Clears
+     * all queued samples.
+     * @param capacities Maximum number of uncombined samples held for each
+     * SOURCE. The oldest sample is dropped when a queue is full.
+     */
+    void reset(const std::vector<size_t> &capacities);
+
+    /**
+     * @brief Set the sync policy.
+     * @param policy Sample selection policy.
+     * @param timeout Time to wait for the samples of a combination to arrive
+     * before combining without them. Not used by SyncPolicy::LATEST.
+     */
+    void set_policy(SyncPolicy policy,
+                    const boost::posix_time::time_duration &timeout)
+    {
+        policy_ = policy;
+        timeout_ = timeout;
+    }
+
+    SyncPolicy policy(void) const { return policy_; }
+    const boost::posix_time::time_duration &timeout(void) const { return timeout_; }
+
+    /**
+     * @brief Queue a sample from a SOURCE. Under SyncPolicy::EXACT, samples
+     * no newer than one that has already been combined are too late and are
+     * discarded.
+     * @param idx SOURCE index.
+     * @param p Sample.
+     * @param arrival Time at which the sample was read.
+     */
+    void push(size_t idx,
+              const oat::Position2D &p,
+              const boost::system_time &arrival);
+
+    /**
+     * @brief Select the samples to combine and remove used samples from the
+     * queues. SOURCES without a sample in the combination are presented as
+     * invalid positions.
+     * @param now Current time.
+     * @param positions Selected samples, one per SOURCE.
+     * @return True if positions holds a set of samples to combine.
+     */
+    bool align(const boost::system_time &now,
+               std::vector<oat::Position2D> &positions);
+
+    /**
+     * @brief SOURCE the next combination is waiting on after align() returns
+     * false.
+     */
+    size_t waiting_on(void) const { return waiting_on_; }
+
+    /**
+     * @brief SOURCE whose sample info should be given to the combination
+     * after align() returns true.
+     */
+    size_t reference(void) const { return reference_; }
+
+    /**
+     * @brief Number of samples currently queued for a SOURCE.
+     */
+    size_t queued(size_t idx) const { return queues_[idx].size; }
+
+private:
+    /**
+     * Fixed capacity queue of samples received from a SOURCE that have not
+     * yet been combined, ordered by arrival. The oldest sample is
+     * overwritten when full.
+     */
+    struct SampleQueue {
+
+        oat::Position2D &at(size_t k)
+        {
+            return samples[(head + k) % samples.size()];
+        }
+
+        boost::system_time &arrival(size_t k)
+        {
+            return arrivals[(head + k) % arrivals.size()];
+        }
+
+        oat::Position2D &back(void) { return at(size - 1); }
+
+        void pop(size_t n = 1)
+        {
+            head = (head + n) % samples.size();
+            size -= n;
+        }
+
+        size_t push(void)
+        {
+            if (size == samples.size())
+                pop();
+            return size++;
+        }
+
+        std::vector<oat::Position2D> samples;
+        std::vector<boost::system_time> arrivals;
+        size_t head {0}, size {0};
+    };
+
+    static void invalidate(oat::Position2D &p)
+    {
+        p.position_valid = false;
+        p.velocity_valid = false;
+        p.heading_valid = false;
+        p.region_valid = false;
+    }
+
+    bool alignExact(const boost::system_time &now,
+                    std::vector<oat::Position2D> &positions);
+    bool alignNearest(const boost::system_time &now,
+                      std::vector<oat::Position2D> &positions);
+    bool alignLatest(std::vector<oat::Position2D> &positions);
+
+    SyncPolicy policy_ {SyncPolicy::EXACT};
+    boost::posix_time::time_duration timeout_ {boost::posix_time::milliseconds(100)};
+    std::vector<SampleQueue> queues_;
+    std::vector<bool> fresh_;
+    uint64_t last_count_ {0};
+    bool combined_any_ {false};
+    size_t waiting_on_ {0};
+    size_t reference_ {0};
+};
+
+inline void SampleAligner::reset(const std::vector<size_t> &capacities)
+{
+    queues_.assign(capacities.size(), SampleQueue());
+    for (size_t i = 0; i < capacities.size(); i++) {
+        queues_[i].samples.resize(std::max<size_t>(capacities[i], 1));
+        queues_[i].arrivals.resize(std::max<size_t>(capacities[i], 1));
+    }
+
+    fresh_.assign(capacities.size(), false);
+    combined_any_ = false;
+    waiting_on_ = 0;
+    reference_ = 0;
+}
+
+inline void SampleAligner::push(size_t idx,
+                                const oat::Position2D &p,
+                                const boost::system_time &arrival)
+{
+    if (policy_ == SyncPolicy::EXACT && combined_any_
+        && p.sample_count() <= last_count_)
+        return;
+
+    auto &q = queues_[idx];
+    const auto k = q.push();
+    q.at(k) = p;
+    q.arrival(k) = arrival;
+    fresh_[idx] = true;
+}
+
+inline bool SampleAligner::align(const boost::system_time &now,
+                                 std::vector<oat::Position2D> &positions)
+{
+    bool aligned = false;
+    switch (policy_) {
+        case SyncPolicy::EXACT:
+            aligned = alignExact(now, positions);
+            break;
+        case SyncPolicy::NEAREST:
+            aligned = alignNearest(now, positions);
+            break;
+        case SyncPolicy::LATEST:
+            aligned = alignLatest(positions);
+            break;
+    }
+
+    if (aligned) {
+        combined_any_ = true;
+        last_count_ = positions[reference_].sample_count();
+    }
+
+    return aligned;
+}
+
+inline bool SampleAligner::alignExact(const boost::system_time &now,
+                                      std::vector<oat::Position2D> &positions)
+{
+    // The oldest pending sample count is combined next
+    bool pending = false;
+    uint64_t count = 0;
+    for (auto &q : queues_) {
+        if (q.size > 0 && (!pending || q.at(0).sample_count() < count)) {
+            count = q.at(0).sample_count();
+            pending = true;
+        }
+    }
+
+    if (!pending) {
+        waiting_on_ = 0;
+        return false;
+    }
+
+    boost::system_time first_arrival = now;
+    for (auto &q : queues_) {
+        if (q.size > 0 && q.at(0).sample_count() == count)
+            first_arrival = std::min(first_arrival, q.arrival(0));
+    }
+
+    // Counts increase, so only a SOURCE with an empty queue can still
+    // provide this count
+    for (size_t i = 0; i < queues_.size(); i++) {
+        if (queues_[i].size == 0 && now < first_arrival + timeout_) {
+            waiting_on_ = i;
+            return false;
+        }
+    }
+
+    bool reference_set = false;
+    for (size_t i = 0; i < queues_.size(); i++) {
+
+        auto &q = queues_[i];
+        if (q.size > 0 && q.at(0).sample_count() == count) {
+            positions[i] = q.at(0);
+            q.pop();
+            if (!reference_set) {
+                reference_ = i;
+                reference_set = true;
+            }
+        } else {
+            invalidate(positions[i]);
+        }
+    }
+
+    return true;
+}
+
+inline bool SampleAligner::alignNearest(const boost::system_time &now,
+                                        std::vector<oat::Position2D> &positions)
+{
+    // The first SOURCE is the reference clock
+    auto &ref_q = queues_[0];
+    if (ref_q.size == 0) {
+        waiting_on_ = 0;
+        return false;
+    }
+
+    const int64_t t = ref_q.at(0).sample_usec();
+
+    // The nearest sample is known once a sample at or after t has arrived
+    if (now < ref_q.arrival(0) + timeout_) {
+        for (size_t i = 1; i < queues_.size(); i++) {
+            auto &q = queues_[i];
+            if (q.size == 0 || static_cast<int64_t>(q.back().sample_usec()) < t) {
+                waiting_on_ = i;
+                return false;
+            }
+        }
+    }
+
+    positions[0] = ref_q.at(0);
+    ref_q.pop();
+    reference_ = 0;
+
+    for (size_t i = 1; i < queues_.size(); i++) {
+
+        auto &q = queues_[i];
+        if (q.size == 0) {
+            invalidate(positions[i]);
+            continue;
+        }
+
+        // Samples are in time order: stop once they get further from t
+        size_t k = 0;
+        int64_t dist = std::llabs(static_cast<int64_t>(q.at(0).sample_usec()) - t);
+        for (size_t j = 1; j < q.size; j++) {
+            const int64_t d
+                = std::llabs(static_cast<int64_t>(q.at(j).sample_usec()) - t);
+            if (d > dist)
+                break;
+            k = j;
+            dist = d;
+        }
+
+        // Keep the chosen sample since it may also be nearest to the next
+        // reference sample
+        positions[i] = q.at(k);
+        q.pop(k);
+    }
+
+    return true;
+}
+
+inline bool SampleAligner::alignLatest(std::vector<oat::Position2D> &positions)
+{
+    if (std::find(fresh_.begin(), fresh_.end(), true) == fresh_.end()) {
+        waiting_on_ = (waiting_on_ + 1) % queues_.size();
+        return false;
+    }
+
+    bool reference_set = false;
+    for (size_t i = 0; i < queues_.size(); i++) {
+
+        auto &q = queues_[i];
+        if (q.size == 0) {
+            invalidate(positions[i]);
+            continue;
+        }
+
+        // Only the most recent sample is ever used
+        q.pop(q.size - 1);
+        positions[i] = q.at(0);
+
+        if (fresh_[i] && (!reference_set
+            || q.at(0).sample_usec() > positions[reference_].sample_usec())) {
+            reference_ = i;
+            reference_set = true;
+        }
+
+        fresh_[i] = false;
+    }
+
+    return true;
+}
+
+}      /* namespace oat */
+#endif /* OAT_SAMPLEALIGNER_H */
@@ -32,6 +32,7 @@
 #include "../../lib/utility/IOFormat.h"
 #include "../../lib/utility/ProgramOptions.h"
 
+#include "FusedPosition.h"
 #include "MeanPosition.h"
 #include "PositionCombiner.h"
 
@@ -41,7 +42,8 @@ namespace po = boost::program_options;
 
 const char usage_type[] =
     "TYPE\n"
-    "  mean: Geometric mean of positions";
+    "  mean: Geometric mean of positions\n"
+    "  fuse: Inverse variance weighted fusion of positions";
 
 const char usage_io[] =
     "SOURCES:\n"
@@ -87,6 +89,7 @@ int main(int argc, char *argv[]) {
     // Component specializations
     std::unordered_map<std::string, char> type_hash;
     type_hash["mean"] = 'a';
+    type_hash["fuse"] = 'b';
 
     // The component itself
     std::string comp_name = "posicom";
@@ -145,6 +148,11 @@ int main(int argc, char *argv[]) {
                     combiner = std::make_shared<oat::MeanPosition>();
                     break;
                 }
+                case 'b':
+                {
+                    combiner = std::make_shared<oat::FusedPosition>();
+                    break;
+                }
                 default:
                 {
                     printUsage(visible_options, "");
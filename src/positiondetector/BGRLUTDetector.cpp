@@ -0,0 +1,119 @@
+//******************************************************************************
+//* File:   BGRLUTDetector.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//****************************************************************************
+
+#include "BGRLUTDetector.h"
+#include "DetectorFunc.h"
+
+#include <algorithm>
+#include <string>
+#include <opencv2/imgproc.hpp>
+
+#include "../../lib/utility/ParallelRows.h"
+
+namespace oat {
+
+// Table words per blue plane
+static constexpr int LUT_PLANE_WORDS {256 * 256 / 64};
+
+/**
+ * Fill a 256x256 BGR matrix with every color of blue plane b: the pixel at
+ * (row g, column r) is (b, g, r).
+ */
+static void bgrPlane(const int b, cv::Mat &plane)
+{
+    plane.create(256, 256, CV_8UC3);
+    for (int g = 0; g < 256; g++) {
+        auto px = plane.ptr<cv::Vec3b>(g);
+        for (int r = 0; r < 256; r++)
+            px[r] = cv::Vec3b(b, g, r);
+    }
+}
+
+/**
+ * Pack a 256x256 binary mask into a blue plane of the table.
+ */
+static void packPlane(const cv::Mat &mask, uint64_t *words)
+{
+    for (int g = 0; g < 256; g++) {
+        const uchar *m = mask.ptr<uchar>(g);
+        for (int w = 0; w < 4; w++, m += 64) {
+            uint64_t word = 0;
+            for (int i = 0; i < 64; i++)
+                word |= static_cast<uint64_t>(m[i] != 0) << i;
+            *words++ = word;
+        }
+    }
+}
+
+BGRLUTDetector::BGRLUTDetector(const std::string &frame_source_address,
+                               const std::string &position_sink_address)
+: HSVDetector(frame_source_address, position_sink_address)
+{
+    // Colors are classified without conversion
+    required_color_ = PIX_BGR;
+}
+
+void BGRLUTDetector::applyConfiguration(
+        const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    HSVDetector::applyConfiguration(vm, config_table);
+
+    const int band[6] {h_min_, h_max_, s_min_, s_max_, v_min_, v_max_};
+    buildLUT(band);
+}
+
+void BGRLUTDetector::applyThreshold(cv::Mat &frame)
+{
+    // Tuning sliders write to the passband directly
+    if (tuning_on_) {
+        const int band[6] {h_min_, h_max_, s_min_, s_max_, v_min_, v_max_};
+        if (!std::equal(band, band + 6, lut_band_))
+            buildLUT(band);
+    }
+
+    lutMorph(frame,
+             lut_.data(),
+             erode_on_ ? searchElement(erode_element_) : cv::Mat(),
+             dilate_on_ ? searchElement(dilate_element_) : cv::Mat(),
+             threshold_frame_);
+}
+
+void BGRLUTDetector::buildLUT(const int *band)
+{
+    lut_.resize(256 * LUT_PLANE_WORDS);
+
+    const cv::Scalar lower(band[0], band[2], band[4]);
+    const cv::Scalar upper(band[1], band[3], band[5]);
+
+    parallelRows(256, [&](const cv::Range &planes) {
+
+        cv::Mat bgr, hsv, mask;
+
+        for (int b = planes.start; b < planes.end; b++) {
+            bgrPlane(b, bgr);
+            cv::cvtColor(bgr, hsv, cv::COLOR_BGR2HSV);
+            cv::inRange(hsv, lower, upper, mask);
+            packPlane(mask, &lut_[b * LUT_PLANE_WORDS]);
+        }
+    }, 1);
+
+    std::copy(band, band + 6, lut_band_);
+}
+
+} /* namespace oat */
@@ -0,0 +1,75 @@
+//******************************************************************************
+//* File:   BGRLUTDetector.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//****************************************************************************
+
+#ifndef OAT_BGRLUTDETECTOR_H
+#define	OAT_BGRLUTDETECTOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <opencv2/core/mat.hpp>
+
+#include "HSVDetector.h"
+
+namespace oat {
+
+class BGRLUTDetector : public HSVDetector {
+
+public:
+    /**
+     * A color-based object position detector configured with HSV passbands
+     * that operates directly on BGR frames. Each BGR color is classified
+     * once, when the passband is set, into a bitset lookup table so that no
+     * color conversion is performed per frame.
+     * @param frame_source_address Frame SOURCE node address
+     * @param position_sink_address Position SINK node address
+     */
+    BGRLUTDetector(const std::string &frame_source_address,
+                   const std::string &position_sink_address);
+
+private:
+    // Configurable Interface
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    /**
+     * Classify BGR pixels through the lookup table and apply erode and dilate
+     * kernels. When tuning, the table is rebuilt first if a slider has
+     * changed the passband. Result is placed in threshold_frame_.
+     * @param frame BGR frame to threshold.
+     */
+    void applyThreshold(cv::Mat &frame) override;
+
+    /**
+     * Build the lookup table for a passband. Every BGR color is converted to
+     * HSV and classified.
+     * @param band Passband, {h_min, h_max, s_min, s_max, v_min, v_max}.
+     */
+    void buildLUT(const int *band);
+
+    // 2^24 bit color membership table indexed by (b << 16) | (g << 8) | r.
+    // Each blue plane is a contiguous block of 1024 words.
+    std::vector<uint64_t> lut_;
+
+    // Passband lut_ was built for
+    int lut_band_[6] {-1, -1, -1, -1, -1, -1};
+};
+
+}       /* namespace oat */
+#endif	/* OAT_BGRLUTDETECTOR_H */
@@ -17,17 +17,33 @@
 //* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
 //****************************************************************************
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <utility>
 #include <vector>
 #include <opencv2/core/mat.hpp>
 #include <opencv2/imgproc.hpp>
 
+#include "../../lib/datatypes/MultiPosition2D.h"
 #include "../../lib/datatypes/Position2D.h"
+#include "../../lib/utility/ParallelRows.h"
 
 #include "DetectorFunc.h"
 
 namespace oat {
 
+// Target input bytes per band in thresholdMorph(). The band and its two
+// binary intermediates should fit comfortably in L2.
+static constexpr int THRESH_MORPH_BAND_BYTES {128 * 1024};
+
+// Minimum major to minor axis length ratio for a contour's orientation to be
+// reported. Orientation of near-circular contours is dominated by noise.
+static constexpr double HEADING_MIN_AXIS_RATIO {1.2};
+
+// Weight of the newest displacement in orientHeading()'s velocity estimate
+static constexpr double HEADING_VELOCITY_ALPHA {0.3};
+
 void siftContours(cv::Mat &frame,
                   Position2D &position,
                   double &area,
@@ -43,7 +59,9 @@ void siftContours(cv::Mat &frame,
                      cv::CHAIN_APPROX_SIMPLE);
 
     double object_area = 0;
+    cv::Moments object_moment;
     position.position_valid = false;
+    position.heading_valid = false;
 
     for (auto &c : contours) {
 
@@ -59,10 +77,235 @@ void siftContours(cv::Mat &frame,
             position.position.y = moment.m01 / countour_area;
             position.position_valid = true;
             object_area = countour_area;
+            object_moment = moment;
         }
     }
 
     area = object_area;
+
+    if (!position.position_valid)
+        return;
+
+    // Major axis of the contour from its second order central moments. The
+    // eigenvalues of the covariance [mu20 mu11; mu11 mu02] are proportional
+    // to the squared axis lengths.
+    const double a = object_moment.mu20;
+    const double b = object_moment.mu11;
+    const double c = object_moment.mu02;
+    const double common = 0.5 * (a + c);
+    const double diff = std::sqrt(0.25 * (a - c) * (a - c) + b * b);
+    const double major = common + diff;
+    const double minor = common - diff;
+
+    if (minor <= 0
+        || major < HEADING_MIN_AXIS_RATIO * HEADING_MIN_AXIS_RATIO * minor)
+        return;
+
+    // Axis only: sign is resolved using motion by orientHeading()
+    const double theta = 0.5 * std::atan2(2.0 * b, a - c);
+    position.heading.x = std::cos(theta);
+    position.heading.y = std::sin(theta);
+    position.heading_valid = true;
+}
+
+void orientHeading(Position2D &position,
+                   HeadingHistory &history,
+                   double min_speed)
+{
+    if (!position.position_valid) {
+
+        // Displacement across a gap is not a velocity
+        history.position_valid = false;
+        return;
+    }
+
+    if (history.position_valid)
+        history.velocity
+            = (1.0 - HEADING_VELOCITY_ALPHA) * history.velocity
+              + HEADING_VELOCITY_ALPHA * (position.position - history.position);
+    else
+        history.velocity = cv::Point2d(0, 0);
+
+    history.position = position.position;
+    history.position_valid = true;
+
+    if (!position.heading_valid)
+        return;
+
+    // Animals mostly move forward, so when moving, point along the velocity.
+    // Otherwise, choose the direction closest to the last heading.
+    double agreement = 0;
+    if (cv::norm(history.velocity) >= min_speed)
+        agreement = position.heading.dot(history.velocity);
+    else if (history.heading_valid)
+        agreement = position.heading.dot(history.heading);
+
+    if (agreement < 0)
+        position.heading = -position.heading;
+
+    history.heading = position.heading;
+    history.heading_valid = true;
+}
+
+void siftBlobs(const cv::Mat &frame,
+               BlobLabels &blobs,
+               MultiPosition2D &positions,
+               double min_area,
+               double max_area,
+               size_t max_count)
+{
+    const int n = cv::connectedComponentsWithStats(
+        frame, blobs.labels, blobs.stats, blobs.centroids, 8, CV_32S);
+
+    const auto area = [&blobs](int label) {
+        return blobs.stats.at<int>(label, cv::CC_STAT_AREA);
+    };
+
+    // Label 0 is background
+    blobs.order.clear();
+    for (int l = 1; l < n; l++) {
+        if (area(l) >= min_area && area(l) < max_area)
+            blobs.order.push_back(l);
+    }
+
+    std::sort(blobs.order.begin(),
+              blobs.order.end(),
+              [&area](int a, int b) { return area(a) > area(b); });
+
+    // NB: Comparison, not std::min, to avoid odr-using MAX_POSITIONS
+    if (max_count > MultiPosition2D::MAX_POSITIONS)
+        max_count = MultiPosition2D::MAX_POSITIONS;
+    if (blobs.order.size() > max_count)
+        blobs.order.resize(max_count);
+
+    positions.clear();
+    for (int l : blobs.order) {
+        Position2D p;
+        p.position.x = blobs.centroids.at<double>(l, 0);
+        p.position.y = blobs.centroids.at<double>(l, 1);
+        p.position_valid = true;
+        positions.push_back(p);
+    }
+}
+
+/**
+ * Banded classify, erode, and dilate shared by thresholdMorph() and
+ * bitplaneMorph(). classify(src, dst) must write a binary CV_8UC1 dst for
+ * the rows of src.
+ */
+template <typename Classifier>
+static void classifyMorph(const cv::Mat &frame,
+                          const Classifier &classify,
+                          const cv::Mat &erode_element,
+                          const cv::Mat &dilate_element,
+                          cv::Mat &out)
+{
+    out.create(frame.size(), CV_8UC1);
+
+    // Rows beyond each band edge that affect morphology within the band
+    const int apron = erode_element.rows + dilate_element.rows;
+
+    const int row_bytes = std::max<int>(frame.cols * frame.elemSize(), 1);
+    const int band_rows
+        = std::max(THRESH_MORPH_BAND_BYTES / row_bytes, std::max(4 * apron, 1));
+
+    // Each worker walks its stripe of rows in cache-sized bands
+    parallelRows(frame.rows, [&](const cv::Range &stripe) {
+
+        // Band buffers are reused so that each band stays cache-resident
+        cv::Mat band, morphed;
+
+        for (int r0 = stripe.start; r0 < stripe.end; r0 += band_rows) {
+
+            const int r1 = std::min(r0 + band_rows, stripe.end);
+
+            // No morphology: classify straight into the output
+            if (apron == 0) {
+                cv::Mat dst = out.rowRange(r0, r1);
+                classify(frame.rowRange(r0, r1), dst);
+                continue;
+            }
+
+            const int a0 = std::max(r0 - apron, 0);
+            const int a1 = std::min(r1 + apron, frame.rows);
+
+            // NB: band is its own matrix, not a view, so morphology treats
+            // its edges as image borders. The apron absorbs the difference.
+            classify(frame.rowRange(a0, a1), band);
+
+            if (!erode_element.empty()) {
+                cv::erode(band, morphed, erode_element);
+                std::swap(band, morphed);
+            }
+
+            if (!dilate_element.empty()) {
+                cv::dilate(band, morphed, dilate_element);
+                std::swap(band, morphed);
+            }
+
+            band.rowRange(r0 - a0, r1 - a0).copyTo(out.rowRange(r0, r1));
+        }
+    }, std::max(16, 2 * apron));
+}
+
+void thresholdMorph(const cv::Mat &frame,
+                    const cv::Scalar &lower,
+                    const cv::Scalar &upper,
+                    const cv::Mat &erode_element,
+                    const cv::Mat &dilate_element,
+                    cv::Mat &out)
+{
+    classifyMorph(frame,
+                  [&](const cv::Mat &src, cv::Mat &dst) {
+                      cv::inRange(src, lower, upper, dst);
+                  },
+                  erode_element,
+                  dilate_element,
+                  out);
+}
+
+void bitplaneMorph(const cv::Mat &bits,
+                   const uchar mask,
+                   const cv::Mat &erode_element,
+                   const cv::Mat &dilate_element,
+                   cv::Mat &out)
+{
+    classifyMorph(bits,
+                  [mask](const cv::Mat &src, cv::Mat &dst) {
+                      dst.create(src.size(), CV_8UC1);
+                      for (int i = 0; i < src.rows; i++) {
+                          const uchar *s = src.ptr<uchar>(i);
+                          uchar *d = dst.ptr<uchar>(i);
+                          for (int j = 0; j < src.cols; j++)
+                              d[j] = (s[j] & mask) ? 255 : 0;
+                      }
+                  },
+                  erode_element,
+                  dilate_element,
+                  out);
+}
+
+void lutMorph(const cv::Mat &frame,
+              const uint64_t *lut,
+              const cv::Mat &erode_element,
+              const cv::Mat &dilate_element,
+              cv::Mat &out)
+{
+    classifyMorph(frame,
+                  [lut](const cv::Mat &src, cv::Mat &dst) {
+                      dst.create(src.size(), CV_8UC1);
+                      for (int i = 0; i < src.rows; i++) {
+                          const uchar *s = src.ptr<uchar>(i);
+                          uchar *d = dst.ptr<uchar>(i);
+                          for (int j = 0; j < src.cols; j++, s += 3) {
+                              const uint32_t c = (s[0] << 16) | (s[1] << 8) | s[2];
+                              d[j] = (lut[c >> 6] >> (c & 63)) & 1 ? 255 : 0;
+                          }
+                      }
+                  },
+                  erode_element,
+                  dilate_element,
+                  out);
 }
 
 } /* namespace oat */
@@ -20,8 +20,9 @@
 #ifndef OAT_DETECTORFUNC
 #define	OAT_DETECTORFUNC
 
-// Forward decl.
-namespace cv { class Mat; }
+#include <cstdint>
+#include <vector>
+#include <opencv2/core.hpp>
 
 namespace oat {
 
@@ -30,10 +31,35 @@ static constexpr double PI {3.14159265358979323846};
 
 // Forward decl.
 class Position2D;
+class MultiPosition2D;
+
+/**
+ * Working buffers for siftBlobs(). Reused between calls so that labeling
+ * does not allocate once frame size and object count are stable.
+ */
+struct BlobLabels {
+    cv::Mat labels, stats, centroids;
+    std::vector<int> order; //!< Accepted labels, largest first
+};
+
+/**
+ * Motion history used by orientHeading() to resolve the head/tail ambiguity
+ * of a contour's axis.
+ */
+struct HeadingHistory {
+    bool position_valid {false};
+    bool heading_valid {false};
+    cv::Point2d position;
+    cv::Point2d velocity; //!< Smoothed, in pixels per frame
+    cv::Point2d heading;
+};
 
 /**
  * Given a binary frame, find all contours and return a position corresponding
- * to the centroid of the largest one.
+ * to the centroid of the largest one. If the contour is elongated, the
+ * heading is set along its major axis, found from its second order central
+ * moments. The sign of this axis is arbitrary; use orientHeading() to
+ * resolve it.
  * @param frame_in Frame to look for positions in.
  * @param position Position output
  * @param min_area Minimum contour area to be considered candidate for position
@@ -46,5 +72,95 @@ void siftContours(cv::Mat &frame,
                   double min_area,
                   double max_area);
 
+/**
+ * Resolve the head/tail ambiguity of a heading found by siftContours(). The
+ * heading is flipped, if needed, to point along the object's recent velocity
+ * or, if the object is moving slower than min_speed, to agree with the
+ * previous heading.
+ * @param position Position whose heading will be oriented. Must be in the
+ * same coordinates on each call.
+ * @param history Motion history. Updated on each call.
+ * @param min_speed Minimum speed, in pixels per frame, for velocity to be used.
+ */
+void orientHeading(Position2D &position,
+                   HeadingHistory &history,
+                   double min_speed);
+
+/**
+ * Given a binary frame, label all 8-connected blobs with
+ * cv::connectedComponentsWithStats() and return positions corresponding to
+ * the centroids of those within the area range, largest first. No contours
+ * are constructed. Blob area is a pixel count, so it is larger than the
+ * contour area used by siftContours() for the same blob by about half its
+ * perimeter, and does not include holes.
+ * @param frame Binary frame to look for positions in.
+ * @param blobs Working buffers. On return, blobs.order holds the labels of
+ * the returned positions, indexing blobs.stats.
+ * @param positions Position output. Cleared before use.
+ * @param min_area Minimum blob pixel count to be considered an object.
+ * @param max_area Maximum blob pixel count to be considered an object.
+ * @param max_count Maximum number of positions to return.
+ */
+void siftBlobs(const cv::Mat &frame,
+               BlobLabels &blobs,
+               MultiPosition2D &positions,
+               double min_area,
+               double max_area,
+               size_t max_count);
+
+/**
+ * Threshold a frame to a passband and then erode and dilate the result. The
+ * frame is processed in row bands small enough to remain in cache between the
+ * threshold, erode, and dilate steps rather than streaming the whole frame
+ * through memory for each. Bands are distributed across worker threads (see
+ * parallelRows()) and overlap by the extent of the morphological kernels so
+ * the result is identical to whole frame processing.
+ * @param frame Frame to threshold.
+ * @param lower Inclusive lower bound of the passband.
+ * @param upper Inclusive upper bound of the passband.
+ * @param erode_element Erosion structuring element. Empty to skip erosion.
+ * @param dilate_element Dilation structuring element. Empty to skip dilation.
+ * @param out Binary output frame.
+ */
+void thresholdMorph(const cv::Mat &frame,
+                    const cv::Scalar &lower,
+                    const cv::Scalar &upper,
+                    const cv::Mat &erode_element,
+                    const cv::Mat &dilate_element,
+                    cv::Mat &out);
+
+/**
+ * Select the pixels of a classification frame that have any of the bits in
+ * mask set and then erode and dilate the result. Processing is banded and
+ * parallel in the same way as thresholdMorph().
+ * @param bits Single channel frame of per-pixel class bits.
+ * @param mask Class bits to select.
+ * @param erode_element Erosion structuring element. Empty to skip erosion.
+ * @param dilate_element Dilation structuring element. Empty to skip dilation.
+ * @param out Binary output frame.
+ */
+void bitplaneMorph(const cv::Mat &bits,
+                   const uchar mask,
+                   const cv::Mat &erode_element,
+                   const cv::Mat &dilate_element,
+                   cv::Mat &out);
+
+/**
+ * Classify the pixels of a BGR frame through a bitset lookup table indexed by
+ * packed 24-bit color, (b << 16) | (g << 8) | r, and then erode and dilate
+ * the result. Processing is banded and parallel in the same way as
+ * thresholdMorph().
+ * @param frame BGR frame to classify.
+ * @param lut 2^24 bit table, 64 colors per word.
+ * @param erode_element Erosion structuring element. Empty to skip erosion.
+ * @param dilate_element Dilation structuring element. Empty to skip dilation.
+ * @param out Binary output frame.
+ */
+void lutMorph(const cv::Mat &frame,
+              const uint64_t *lut,
+              const cv::Mat &erode_element,
+              const cv::Mat &dilate_element,
+              cv::Mat &out);
+
 }       /* namespace oat */
 #endif	/* OAT_DETECTORFUNC */
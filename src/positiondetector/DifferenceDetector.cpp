@@ -21,6 +21,7 @@
 #include "DetectorFunc.h"
 
 #include <string>
+#include <utility>
 #include <opencv2/cvconfig.h>
 #include <opencv2/opencv.hpp>
 #include <cpptoml.h>
@@ -52,6 +53,10 @@ po::options_description DifferenceDetector::options() const
          "Intensity difference threshold to consider an object contour.")
         ("blur,b", po::value<int>(),
          "Blurring kernel size in pixels (normalized box filter).")
+        ("stride,s", po::value<int>(),
+         "Difference each frame against the frame this many samples "
+         "earlier. Larger values increase sensitivity to slowly moving "
+         "objects at no extra cost. Defaults to 1.")
         ("area,a", po::value<std::string>(),
          "Array of floats, [min,max], specifying the minimum and maximum "
          "object contour area in pixels^2.")
@@ -60,6 +65,8 @@ po::options_description DifferenceDetector::options() const
          "parameters.")
         ;
 
+    appendHeadingOptions(local_opts);
+
     return local_opts;
 }
 
@@ -71,6 +78,9 @@ void DifferenceDetector::applyConfiguration(
         vm, config_table, "diff-threshold", difference_intensity_threshold_, 0
     );
 
+    // Temporal stride
+    oat::config::getNumericValue<int>(vm, config_table, "stride", stride_, 1);
+
     // Blur size
     int blur;
     if (oat::config::getNumericValue<int>(vm, config_table, "blur", blur, 0))
@@ -93,13 +103,16 @@ void DifferenceDetector::applyConfiguration(
 
     // Tuning GUI
     oat::config::getValue<bool>(vm, config_table, "tune", tuning_on_);
+
+    // Heading
+    applyHeadingConfiguration(vm, config_table);
 }
 
 void DifferenceDetector::detectPosition(cv::Mat &frame,
                                         oat::Position2D &position)
 {
     if (tuning_on_)
-        tune_frame_ = frame.clone();
+        frame.copyTo(tune_frame_);
 
     applyThreshold(frame);
 
@@ -153,22 +166,33 @@ void DifferenceDetector::tune(cv::Mat &frame, const oat::Position2D &position) {
 
 void DifferenceDetector::applyThreshold(cv::Mat &frame) {
 
-    if (last_image_set_) {
-        cv::absdiff(frame, last_image_, threshold_frame_);
-        cv::threshold(threshold_frame_,
-                      threshold_frame_,
-                      difference_intensity_threshold_,
-                      255,
-                      cv::THRESH_BINARY);
-        if (blur_on_)
-            cv::blur(threshold_frame_, threshold_frame_, blur_size_);
+    if (history_.empty())
+        history_.resize(stride_ + 1);
+
+    // Overwrite the oldest frame and advance to the next oldest, which is
+    // stride_ samples behind this one. Slots are reused, so no allocation
+    // occurs once the ring is full.
+    frame.copyTo(history_[head_]);
+    head_ = (head_ + 1) % history_.size();
+
+    // Nothing to compare against yet
+    if (history_count_ < stride_) {
+        history_count_++;
+        threshold_frame_.create(frame.size(), CV_8UC1);
+        threshold_frame_.setTo(0);
+        return;
+    }
 
+    cv::absdiff(frame, history_[head_], threshold_frame_);
+    cv::threshold(threshold_frame_,
+                  threshold_frame_,
+                  difference_intensity_threshold_,
+                  255,
+                  cv::THRESH_BINARY);
 
-        last_image_ = frame.clone(); // Get a copy of the last image
-    } else {
-        threshold_frame_ = frame.clone();
-        last_image_ = frame.clone();
-        last_image_set_ = true;
+    if (blur_on_) {
+        cv::blur(threshold_frame_, blur_frame_, blur_size_);
+        std::swap(threshold_frame_, blur_frame_);
     }
 }
 
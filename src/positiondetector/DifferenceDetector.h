@@ -23,6 +23,7 @@
 #include "PositionDetector.h"
 
 #include <limits>
+#include <vector>
 
 namespace oat {
 
@@ -57,13 +58,15 @@ private:
 
     void detectPosition(cv::Mat &frame, oat::Position2D &position) override;
 
-    // Intermediate variables
-    cv::Mat this_image_, last_image_;
-    cv::Mat threshold_frame_;
-    bool last_image_set_ {false};
+    // Ring of the last stride_ + 1 frames. head_ indexes the slot that
+    // will be overwritten next, which holds the oldest frame.
+    int stride_ {1};
+    std::vector<cv::Mat> history_;
+    size_t head_ {0};
+    int history_count_ {0};
 
-    // Object detection
-    double object_area_ {0.0};
+    // Intermediate variables. Swapped, not reallocated, between steps.
+    cv::Mat threshold_frame_, blur_frame_;
 
     // Set blur kernel
     cv::Size blur_size_;
@@ -27,6 +27,7 @@
 
 #include "../../lib/datatypes/Position2D.h"
 #include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/ParallelRows.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -50,7 +51,24 @@ po::options_description HSVDetector::options() const
 {
     // Update CLI options
     po::options_description local_opts;
-    local_opts.add_options()
+    appendHSVOptions(local_opts,
+                     "Area is enclosed by the object's contour, in pixels^2.");
+    appendTrackingOptions(local_opts);
+    appendPyramidOptions(local_opts);
+    appendHeadingOptions(local_opts);
+    appendThreadOptions(local_opts);
+
+    return local_opts;
+}
+
+void HSVDetector::appendHSVOptions(po::options_description &opts,
+                                   const std::string &area_help) const
+{
+    const std::string area_desc
+        = "Array of floats, [min,max], specifying the minimum and maximum "
+          "object area. " + area_help;
+
+    opts.add_options()
         ("h-thresh,H", po::value<std::string>(),
          "Array of ints between 0 and 256, [min,max], specifying the hue "
          "passband.")
@@ -64,18 +82,32 @@ po::options_description HSVDetector::options() const
          "Contour erode kernel size in pixels (normalized box filter).")
         ("dilate,d", po::value<int>(),
          "Contour dilation kernel size in pixels (normalized box filter).")
-        ("area,a", po::value<std::string>(),
-         "Array of floats, [min,max], specifying the minimum and maximum "
-         "object contour area in pixels^2.")
+        ("area,a", po::value<std::string>(), area_desc.c_str())
         ("tune,t",
          "If true, provide a GUI with sliders for tuning detection parameters.")
         ;
-
-    return local_opts;
 }
 
 void HSVDetector::applyConfiguration(const po::variables_map &vm,
                                      const config::OptionTable &config_table)
+{
+    applyHSVConfiguration(vm, config_table);
+
+    // Region of interest tracking
+    applyTrackingConfiguration(vm, config_table);
+
+    // Coarse-to-fine search
+    applyPyramidConfiguration(vm, config_table);
+
+    // Heading
+    applyHeadingConfiguration(vm, config_table);
+
+    // Worker threads
+    applyThreadConfiguration(vm, config_table);
+}
+
+void HSVDetector::applyHSVConfiguration(const po::variables_map &vm,
+                                        const config::OptionTable &config_table)
 {
     // Hue
     std::vector<int> h;
@@ -141,37 +173,55 @@ void HSVDetector::applyConfiguration(const po::variables_map &vm,
 
 void HSVDetector::detectPosition(cv::Mat &frame, oat::Position2D &position)
 {
-    // Threshold HSV channels
-    // (Very expensive operation)
-    cv::inRange(frame,
-                cv::Scalar(h_min_, s_min_, v_min_),
-                cv::Scalar(h_max_, s_max_, v_max_),
-                threshold_frame_);
+    // Windowed and subsampled searches are shown by tuneSearch()
+    const bool tune_here = tuning_on_ && !partialSearch();
 
-    // Filter the resulting threshold image
-    if (erode_on_)
-        cv::erode(threshold_frame_, threshold_frame_, erode_element_);
-
-    if (dilate_on_)
-        cv::dilate(threshold_frame_, threshold_frame_, dilate_element_);
+    applyThreshold(frame);
 
     // Threshold frame will be destroyed by the transform below, so we need to use
     // it to form the frame that will be shown in the tuning window here
-    if (tuning_on_)
+    if (tune_here)
         frame.setTo(0, threshold_frame_ == 0).clone();
 
     // Find the largest contour in the threshold image
     siftContours(threshold_frame_,
                  position,
                  object_area_,
-                 min_object_area_,
-                 max_object_area_);
+                 min_object_area_ * area_scale_,
+                 max_object_area_ * area_scale_);
 
     // Use the GUI tuner if requested
-    if (tuning_on_)
+    if (tune_here)
         tune(frame, position);
 }
 
+void HSVDetector::tuneSearch(cv::Mat &frame, const oat::Position2D &position)
+{
+    if (!tuning_on_)
+        return;
+
+    // Searches may only have demosaiced the window they looked in
+    demosaicSearch(cv::Rect());
+
+    // Threshold the whole frame so that the view does not depend on which
+    // window or pyramid level the object was found in
+    applyThreshold(frame);
+    frame.setTo(0, threshold_frame_ == 0);
+    tune(frame, position);
+}
+
+void HSVDetector::applyThreshold(cv::Mat &frame)
+{
+    // Threshold HSV channels and filter the resulting threshold image in
+    // cache-sized bands (very expensive operation if done in separate passes)
+    thresholdMorph(frame,
+                   cv::Scalar(h_min_, s_min_, v_min_),
+                   cv::Scalar(h_max_, s_max_, v_max_),
+                   erode_on_ ? searchElement(erode_element_) : cv::Mat(),
+                   dilate_on_ ? searchElement(dilate_element_) : cv::Mat(),
+                   threshold_frame_);
+}
+
 void HSVDetector::tune(cv::Mat &frame, const oat::Position2D &position)
 {
     if (!tuning_windows_created_)
@@ -60,18 +60,34 @@ public:
     HSVDetector(const std::string &frame_source_address,
                 const std::string &position_sink_address);
 
-private:
+protected:
     // Configurable Interface
     po::options_description options() const override;
     void applyConfiguration(const po::variables_map &vm,
                             const config::OptionTable &config_table) override;
 
+    // Color threshold, morphology, area, and tuning options shared with
+    // detectors that extend this one. area_help describes how object area is
+    // measured.
+    void appendHSVOptions(po::options_description &opts,
+                          const std::string &area_help) const;
+    void applyHSVConfiguration(const po::variables_map &vm,
+                               const config::OptionTable &config_table);
+
     /**
      * Perform color-based object position detection.
      * @param Frame to look for object within.
      * @param position Detected object position.
      */
     void detectPosition(cv::Mat &frame, oat::Position2D &position) override;
+    void tuneSearch(cv::Mat &frame, const oat::Position2D &position) override;
+
+    /**
+     * Threshold HSV channels and apply erode and dilate kernels. Result is
+     * placed in threshold_frame_.
+     * @param frame HSV frame to threshold.
+     */
+    virtual void applyThreshold(cv::Mat &frame);
 
     // Erode and dilate kernels
     int erode_px_ {0}, dilate_px_ {10};
@@ -89,7 +105,6 @@ private:
     int dummy0_ {0}, dummy1_ {100000};
 
     // Detect object area
-    double object_area_ {0.0};
     double min_object_area_ {0.0};
     double max_object_area_ {std::numeric_limits<double>::max()};
 
@@ -0,0 +1,286 @@
+//******************************************************************************
+//* File:   MultiBandHSVDetector.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//****************************************************************************
+
+#include "MultiBandHSVDetector.h"
+#include "DetectorFunc.h"
+
+#include <algorithm>
+#include <string>
+#include <opencv2/imgproc.hpp>
+
+#include "../../lib/datatypes/Position2D.h"
+#include "../../lib/utility/ParallelRows.h"
+#include "../../lib/utility/TOMLSanitize.h"
+#include "../../lib/utility/make_unique.h"
+
+namespace oat {
+
+MultiBandHSVDetector::MultiBandHSVDetector(
+    const std::string &frame_source_address,
+    const std::string &position_sink_address)
+: PositionDetector(frame_source_address, position_sink_address)
+, position_sink_prefix_(position_sink_address)
+{
+    set_erode_size(0);
+    set_dilate_size(10);
+
+    // Set required frame type
+    required_color_ = PIX_HSV;
+}
+
+po::options_description MultiBandHSVDetector::options() const
+{
+    // Update CLI options
+    po::options_description local_opts;
+    local_opts.add_options()
+        ("h-thresh,H", po::value<std::string>(),
+         "Array of ints between 0 and 256, [min0,max0,min1,max1,...], "
+         "specifying the hue passband of each object. Its length sets the "
+         "number of passbands, K, which must be at most 8. The object found "
+         "in passband k is published to SINK_k.")
+        ("s-thresh,S", po::value<std::string>(),
+         "Array of ints between 0 and 256, [min0,max0,min1,max1,...], "
+         "specifying the saturation passband of each object. Defaults to "
+         "[0,256] for each passband.")
+        ("v-thresh,V", po::value<std::string>(),
+         "Array of ints between 0 and 256, [min0,max0,min1,max1,...], "
+         "specifying the value passband of each object. Defaults to "
+         "[0,256] for each passband.")
+        ("erode,e", po::value<int>(),
+         "Contour erode kernel size in pixels (normalized box filter).")
+        ("dilate,d", po::value<int>(),
+         "Contour dilation kernel size in pixels (normalized box filter).")
+        ("area,a", po::value<std::string>(),
+         "Array of floats, [min,max], specifying the minimum and maximum "
+         "object contour area in pixels^2.")
+        ;
+
+    appendHeadingOptions(local_opts);
+    appendThreadOptions(local_opts);
+
+    return local_opts;
+}
+
+void MultiBandHSVDetector::applyConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Passbands
+    std::vector<int> h, s, v;
+    oat::config::getArray<int>(vm, config_table, "h-thresh", h, true);
+
+    if (h.empty() || h.size() % 2 != 0 || h.size() > 2 * MAX_BANDS)
+        throw std::runtime_error("h-thresh must contain between 1 and "
+                                 + std::to_string(MAX_BANDS)
+                                 + " [min,max] pairs.");
+
+    num_bands_ = h.size() / 2;
+
+    if (!oat::config::getArray<int>(vm, config_table, "s-thresh", s))
+        for (size_t k = 0; k < num_bands_; k++)
+            s.insert(s.end(), {0, 256});
+
+    if (!oat::config::getArray<int>(vm, config_table, "v-thresh", v))
+        for (size_t k = 0; k < num_bands_; k++)
+            v.insert(v.end(), {0, 256});
+
+    if (s.size() != h.size() || v.size() != h.size())
+        throw std::runtime_error(
+            "h-thresh, s-thresh, and v-thresh must specify the same number of "
+            "passbands.");
+
+    // Set bit k of each table entry within passband k
+    const auto build_lut = [this](const std::vector<int> &band,
+                                  uchar *lut,
+                                  const std::string &key) {
+        std::fill(lut, lut + 256, 0);
+        for (size_t k = 0; k < num_bands_; k++) {
+
+            const int lo = band[2 * k];
+            const int hi = band[2 * k + 1];
+
+            if (lo < 0 || lo > 256 || hi < 0 || hi > 256)
+                throw std::runtime_error("Values of " + key
+                                         + " should be between 0 and 256.");
+
+            for (int i = lo; i <= hi && i < 256; i++)
+                lut[i] |= static_cast<uchar>(1 << k);
+        }
+    };
+
+    build_lut(h, h_lut_, "h-thresh");
+    build_lut(s, s_lut_, "s-thresh");
+    build_lut(v, v_lut_, "v-thresh");
+
+    positions_.assign(num_bands_, oat::Position2D(""));
+    heading_histories_.assign(num_bands_, oat::HeadingHistory());
+
+    // Erode size
+    int erode;
+    if (oat::config::getNumericValue<int>(vm, config_table, "erode", erode, 0))
+        set_erode_size(erode);
+
+    // Dilate size
+    int dilate;
+    if (oat::config::getNumericValue<int>(vm, config_table, "dilate", dilate, 0))
+        set_dilate_size(dilate);
+
+    // Min/max object area
+    std::vector<double> area;
+    if (oat::config::getArray<double, 2>(vm, config_table, "area", area)) {
+
+        min_object_area_ = area[0];
+        max_object_area_ = area[1];
+
+        if (min_object_area_ >= max_object_area_)
+           throw std::runtime_error("Max area should be larger than min area.");
+    }
+
+    // Heading
+    applyHeadingConfiguration(vm, config_table);
+
+    // Worker threads
+    applyThreadConfiguration(vm, config_table);
+}
+
+bool MultiBandHSVDetector::connectToNode()
+{
+    if (!connectToSource())
+        return false;
+
+    // Bind to sink nodes and create a shared position for each passband
+    for (size_t k = 0; k < num_bands_; k++) {
+
+        const auto addr = position_sink_prefix_ + "_" + std::to_string(k);
+        position_sinks_.push_back(
+            oat::make_unique<oat::Sink<oat::Position2D>>());
+        position_sinks_.back()->bind(addr, addr);
+        shared_positions_.push_back(position_sinks_.back()->retrieve());
+    }
+
+    return true;
+}
+
+int MultiBandHSVDetector::process()
+{
+    if (!pullFrame(frame_))
+        return 1;
+
+    const cv::Rect roi = sourceROI();
+    demosaicRegion(frame_, roi);
+    cv::Mat search_frame = searchRegion(frame_);
+
+    detectBands(search_frame);
+
+    for (size_t k = 0; k < num_bands_; k++) {
+
+        oat::Position2D &p = positions_[k];
+        p.set_sample(frame_.sample());
+
+        if (p.position_valid) {
+            p.position.x += roi.x;
+            p.position.y += roi.y;
+        }
+
+        orientHeading(p, heading_histories_[k], heading_min_speed_);
+    }
+
+    for (size_t k = 0; k < num_bands_; k++) {
+
+        // START CRITICAL SECTION //
+        ////////////////////////////
+
+        // Wait for sources to read
+        position_sinks_[k]->wait();
+
+        *shared_positions_[k] = positions_[k];
+
+        // Tell sources there is new data
+        position_sinks_[k]->post();
+
+        ////////////////////////////
+        //  END CRITICAL SECTION  //
+    }
+
+    // Sink was not at END state
+    return 0;
+}
+
+void MultiBandHSVDetector::detectBands(cv::Mat &frame)
+{
+    // Single pass over the frame for all passbands
+    classify(frame);
+
+    for (size_t k = 0; k < num_bands_; k++) {
+
+        oat::Position2D &p = positions_[k];
+
+        bitplaneMorph(bits_,
+                      static_cast<uchar>(1 << k),
+                      erode_on_ ? erode_element_ : cv::Mat(),
+                      dilate_on_ ? dilate_element_ : cv::Mat(),
+                      threshold_frame_);
+
+        double area;
+        siftContours(threshold_frame_,
+                     p,
+                     area,
+                     min_object_area_,
+                     max_object_area_);
+    }
+}
+
+void MultiBandHSVDetector::classify(const cv::Mat &frame)
+{
+    bits_.create(frame.size(), CV_8UC1);
+
+    parallelRows(frame.rows, [&](const cv::Range &rows) {
+        for (int i = rows.start; i < rows.end; i++) {
+
+            const cv::Vec3b *px = frame.ptr<cv::Vec3b>(i);
+            uchar *b = bits_.ptr<uchar>(i);
+
+            for (int j = 0; j < frame.cols; j++)
+                b[j] = h_lut_[px[j][0]] & s_lut_[px[j][1]] & v_lut_[px[j][2]];
+        }
+    });
+}
+
+void MultiBandHSVDetector::set_erode_size(int value)
+{
+    if (value > 0) {
+        erode_on_ = true;
+        erode_px_ = value;
+        erode_element_ = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(erode_px_, erode_px_));
+    } else {
+        erode_on_ = false;
+    }
+}
+
+void MultiBandHSVDetector::set_dilate_size(int value)
+{
+    if (value > 0) {
+        dilate_on_ = true;
+        dilate_px_ = value;
+        dilate_element_ = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(dilate_px_, dilate_px_));
+    } else {
+        dilate_on_ = false;
+    }
+}
+
+} /* namespace oat */
@@ -0,0 +1,102 @@
+//******************************************************************************
+//* File:   MultiBandHSVDetector.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//****************************************************************************
+
+#ifndef OAT_MULTIBANDHSVDETECTOR_H
+#define	OAT_MULTIBANDHSVDETECTOR_H
+
+#include "PositionDetector.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace oat {
+
+class MultiBandHSVDetector : public PositionDetector {
+
+public:
+    /**
+     * A color-based object position detector for several HSV passbands at
+     * once. Each frame is read from the SOURCE and classified against every
+     * passband in a single pass. The object found in passband k is published
+     * to SINK_k.
+     * @param frame_source_address Frame SOURCE node address
+     * @param position_sink_address Position SINK node address prefix
+     */
+    MultiBandHSVDetector(const std::string &frame_source_address,
+                         const std::string &position_sink_address);
+
+    // Number of bits in a classification frame pixel
+    static constexpr size_t MAX_BANDS {8};
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    // Component Interface
+    bool connectToNode(void) override;
+    int process(void) override;
+
+    /**
+     * Perform color-based object position detection for all passbands.
+     * Results are placed in positions_.
+     * @param Frame to look for objects within.
+     */
+    void detectBands(cv::Mat &frame);
+
+    /**
+     * Classify each pixel of an HSV frame against all passbands. Bit k of
+     * each pixel in bits_ is set if the pixel is in passband k.
+     * @param frame HSV frame to classify.
+     */
+    void classify(const cv::Mat &frame);
+
+    // Per-channel passband membership tables. Passbands are boxes in HSV
+    // space, so the 256^3 membership table is the AND of these three.
+    uchar h_lut_[256] {0}, s_lut_[256] {0}, v_lut_[256] {0};
+    size_t num_bands_ {0};
+
+    // Sizes of the erode and dilate blocks
+    int erode_px_ {0}, dilate_px_ {10};
+    bool erode_on_ {false}, dilate_on_ {false};
+    void set_erode_size(int erode_px);
+    void set_dilate_size(int dilate_px);
+
+    // Internal matricies
+    cv::Mat bits_, threshold_frame_, erode_element_, dilate_element_;
+
+    // Detect object area
+    double min_object_area_ {0.0};
+    double max_object_area_ {std::numeric_limits<double>::max()};
+
+    // Detected positions, one per passband
+    std::vector<oat::Position2D> positions_;
+    std::vector<oat::HeadingHistory> heading_histories_;
+
+    // Position sinks, one per passband
+    const std::string position_sink_prefix_;
+    std::vector<oat::Position2D *> shared_positions_;
+    std::vector<std::unique_ptr<oat::Sink<oat::Position2D>>> position_sinks_;
+};
+
+}       /* namespace oat */
+#endif	/* OAT_MULTIBANDHSVDETECTOR_H */
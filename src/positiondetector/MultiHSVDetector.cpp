@@ -0,0 +1,145 @@
+//******************************************************************************
+//* File:   MultiHSVDetector.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//****************************************************************************
+
+#include "MultiHSVDetector.h"
+
+#include <string>
+#include <opencv2/core.hpp>
+
+#include "../../lib/utility/ParallelRows.h"
+#include "../../lib/utility/TOMLSanitize.h"
+
+namespace oat {
+
+MultiHSVDetector::MultiHSVDetector(const std::string &frame_source_address,
+                                   const std::string &positions_sink_address)
+: HSVDetector(frame_source_address, positions_sink_address)
+, positions_sink_address_(positions_sink_address)
+{
+    // Nothing
+}
+
+po::options_description MultiHSVDetector::options() const
+{
+    // Update CLI options
+    po::options_description local_opts;
+    appendHSVOptions(local_opts,
+                     "Area is the object's pixel count, which, for the same "
+                     "object, exceeds the contour area used by the hsv "
+                     "detector by about half its perimeter and does not "
+                     "include holes.");
+    local_opts.add_options()
+        ("max-objects,n", po::value<size_t>(),
+         "Maximum number of objects to publish, largest first. Defaults to "
+         "32, which is also the upper limit.")
+        ;
+    appendThreadOptions(local_opts);
+
+    return local_opts;
+}
+
+void MultiHSVDetector::applyConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    applyHSVConfiguration(vm, config_table);
+
+    // Object count
+    oat::config::getNumericValue<size_t>(vm,
+                                         config_table,
+                                         "max-objects",
+                                         max_objects_,
+                                         1,
+                                         MultiPosition2D::MAX_POSITIONS);
+
+    // Worker threads
+    applyThreadConfiguration(vm, config_table);
+}
+
+bool MultiHSVDetector::connectToNode()
+{
+    if (!connectToSource())
+        return false;
+
+    // Bind to sink node and create a shared position set
+    positions_sink_.bind(positions_sink_address_, positions_sink_address_);
+    shared_positions_ = positions_sink_.retrieve();
+
+    return true;
+}
+
+int MultiHSVDetector::process()
+{
+    if (!pullFrame(frame_))
+        return 1;
+
+    const cv::Rect roi = sourceROI();
+    demosaicRegion(frame_, roi);
+    cv::Mat search_frame = searchRegion(frame_);
+
+    applyThreshold(search_frame);
+
+    // Form the frame that will be shown in the tuning window
+    if (tuning_on_)
+        search_frame.setTo(0, threshold_frame_ == 0);
+
+    // Find all objects in a single pass
+    positions_.set_sample(frame_.sample());
+    siftBlobs(threshold_frame_,
+              blobs_,
+              positions_,
+              min_object_area_,
+              max_object_area_,
+              max_objects_);
+
+    // Use the GUI tuner if requested. Shows the largest object.
+    if (tuning_on_) {
+        oat::Position2D largest;
+        object_area_ = 0.0;
+        if (!positions_.empty()) {
+            largest = positions_[0];
+            object_area_
+                = blobs_.stats.at<int>(blobs_.order[0], cv::CC_STAT_AREA);
+        }
+        tune(search_frame, largest);
+    }
+
+    for (auto &p : positions_) {
+        p.position.x += roi.x;
+        p.position.y += roi.y;
+    }
+
+    // START CRITICAL SECTION //
+    ////////////////////////////
+
+    // Wait for sources to read
+    positions_sink_.wait();
+
+    *shared_positions_ = positions_;
+
+    // Tell sources there is new data
+    positions_sink_.post();
+
+    ////////////////////////////
+    //  END CRITICAL SECTION  //
+
+    // Sink was not at END state
+    return 0;
+}
+
+} /* namespace oat */
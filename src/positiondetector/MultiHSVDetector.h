@@ -0,0 +1,72 @@
+//******************************************************************************
+//* File:   MultiHSVDetector.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//****************************************************************************
+
+#ifndef OAT_MULTIHSVDETECTOR_H
+#define	OAT_MULTIHSVDETECTOR_H
+
+#include <string>
+
+#include "../../lib/datatypes/MultiPosition2D.h"
+#include "../../lib/shmemdf/Sink.h"
+
+#include "DetectorFunc.h"
+#include "HSVDetector.h"
+
+namespace oat {
+
+class MultiHSVDetector : public HSVDetector {
+
+public:
+    /**
+     * A color-based, multi-object position detector. All objects within the
+     * HSV passband and area range found in a single pass over each frame
+     * are published together.
+     * @param frame_source_address Frame SOURCE node address
+     * @param positions_sink_address Multi-position SINK node address
+     */
+    MultiHSVDetector(const std::string &frame_source_address,
+                     const std::string &positions_sink_address);
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    // Component Interface
+    bool connectToNode(void) override;
+    int process(void) override;
+
+    // Maximum number of objects to publish
+    size_t max_objects_ {MultiPosition2D::MAX_POSITIONS};
+
+    // Connected component labeling buffers
+    oat::BlobLabels blobs_;
+
+    // Detected positions
+    oat::MultiPosition2D positions_ {""};
+
+    // Multi-position sink
+    const std::string positions_sink_address_;
+    oat::MultiPosition2D * shared_positions_ {nullptr};
+    oat::Sink<oat::MultiPosition2D> positions_sink_;
+};
+
+}       /* namespace oat */
+#endif	/* OAT_MULTIHSVDETECTOR_H */
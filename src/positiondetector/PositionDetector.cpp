@@ -17,13 +17,20 @@
 //* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
 //******************************************************************************
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <string>
 #include <opencv2/core/mat.hpp>
+#include <opencv2/imgproc.hpp>
 
+#include "../../lib/datatypes/Demosaic.h"
 #include "../../lib/datatypes/Position2D.h"
 #include "../../lib/shmemdf/Source.h"
 #include "../../lib/shmemdf/Sink.h"
+#include "../../lib/utility/TOMLSanitize.h"
 
+#include "DetectorFunc.h"
 #include "PositionDetector.h"
 
 namespace oat {
@@ -37,7 +44,82 @@ PositionDetector::PositionDetector(const std::string &frame_source_address,
   // Nothing
 }
 
-bool PositionDetector::connectToNode()
+void PositionDetector::appendTrackingOptions(po::options_description &opts) const
+{
+    opts.add_options()
+        ("track",
+         "If true, once the object is found, search for it only within an "
+         "adaptive window around its predicted position instead of the "
+         "whole frame. The window is sized using the object's area and "
+         "velocity and grows with each consecutive miss.")
+        ("track-scale", po::value<double>(),
+         "Half-width of the tracking window as a multiple of the object's "
+         "radius. Defaults to 4.")
+        ("track-misses", po::value<int>(),
+         "Number of consecutive misses within the tracking window before "
+         "falling back to a full-frame search. Defaults to 5.")
+        ;
+}
+
+void PositionDetector::applyTrackingConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    oat::config::getValue<bool>(vm, config_table, "track", tracking_on_);
+
+    oat::config::getNumericValue<double>(
+        vm, config_table, "track-scale", track_scale_, 1.0);
+
+    oat::config::getNumericValue<int>(
+        vm, config_table, "track-misses", max_track_misses_, 1);
+}
+
+void PositionDetector::appendPyramidOptions(po::options_description &opts) const
+{
+    opts.add_options()
+        ("pyramid", po::value<int>(),
+         "Number of 2x pyramid levels, between 0 and 3, to subsample frames "
+         "by before searching for the object. The coarse hit is refined at "
+         "full resolution within a window around it, so the result matches "
+         "a full resolution search unless the object is not found in the "
+         "window, in which case the coarse position, accurate to 2^pyramid "
+         "pixels, is used. Objects must remain at least a few pixels across "
+         "after subsampling. Defaults to 0 (full resolution search).")
+        ;
+}
+
+void PositionDetector::applyPyramidConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    oat::config::getNumericValue<int>(
+        vm, config_table, "pyramid", pyramid_levels_, 0, 3);
+}
+
+void PositionDetector::appendHeadingOptions(po::options_description &opts) const
+{
+    opts.add_options()
+        ("heading-speed", po::value<double>(),
+         "Heading is found along the major axis of elongated objects. Its "
+         "direction is chosen to match the object's velocity when the object "
+         "moves faster than this speed, in pixels per frame, and to agree "
+         "with the previous heading otherwise. Defaults to 1.")
+        ;
+}
+
+void PositionDetector::applyHeadingConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    oat::config::getNumericValue<double>(
+        vm, config_table, "heading-speed", heading_min_speed_, 0.0);
+}
+
+void PositionDetector::detectPosition(cv::Mat &, oat::Position2D &)
+{
+    // Detectors without a single position override process(), which is the
+    // only caller, so reaching this is a programming error
+    throw std::runtime_error(name_ + " does not detect a single position.");
+}
+
+bool PositionDetector::connectToSource()
 {
     // Establish our a slot in the node
     frame_source_.touch(frame_source_address_);
@@ -46,29 +128,49 @@ bool PositionDetector::connectToNode()
     if (frame_source_.connect(required_color_) != SourceState::CONNECTED)
         return false;
 
+    // Raw Bayer frames are demosaiced here, and only to the color the
+    // detector actually needs
+    demosaic_ = frame_source_.parameters().color != required_color_;
+
+    return true;
+}
+
+bool PositionDetector::connectToNode()
+{
+    if (!connectToSource())
+        return false;
+
     // Bind to sink node and create a shared position
     position_sink_.bind(position_sink_address_, position_sink_address_);
     shared_position_ = position_sink_.retrieve();
 
-    // TODO: check that the pixel color is correct.
-
     return true;
 }
 
-int PositionDetector::process()
+bool PositionDetector::pullFrame(oat::Frame &frame)
 {
-    oat::Frame internal_frame;
-    oat::Position2D internal_pos("");
-
     // START CRITICAL SECTION //
     ////////////////////////////
 
     // Wait for sink to write to node
     if (frame_source_.wait() == oat::NodeState::END)
-        return 1;
+        return false;
 
-    // Clone the shared frame
-    frame_source_.copyTo(internal_frame);
+    // Clone the shared frame. Raw mosaics are a third of the size of a
+    // demosaiced frame, so copy those and interpolate outside the critical
+    // section, and then only where needed.
+    if (demosaic_) {
+        const oat::Frame *raw = frame_source_.retrieve();
+        static_cast<const cv::Mat &>(*raw).copyTo(raw_frame_);
+        frame.set_sample(raw->sample());
+        frame.create(raw_frame_.rows,
+                     raw_frame_.cols,
+                     oat::cv_type(required_color_));
+        frame.set_color(required_color_);
+        demosaiced_ = cv::Rect();
+    } else {
+        frame_source_.copyTo(frame);
+    }
 
     // Tell sink it can continue
     frame_source_.post();
@@ -76,9 +178,86 @@ int PositionDetector::process()
     ////////////////////////////
     //  END CRITICAL SECTION  //
 
+    return true;
+}
+
+void PositionDetector::demosaicRegion(oat::Frame &frame, cv::Rect region)
+{
+    if (!demosaic_)
+        return;
+
+    const cv::Rect frame_rect(0, 0, frame.cols, frame.rows);
+    region = region.area() > 0 ? region & frame_rect : frame_rect;
+
+    // E.g. a pyramid refinement window within an already searched frame
+    if ((region & demosaiced_) == region)
+        return;
+
+    // Header only, so the result is written in place
+    cv::Mat out = frame(region);
+    oat::demosaic(raw_frame_,
+                  frame_source_.parameters().color,
+                  out,
+                  required_color_,
+                  region);
+
+    demosaiced_ = region;
+}
+
+void PositionDetector::demosaicSearch(const cv::Rect &region)
+{
+    const cv::Rect search_rect(search_origin_, search_size_);
+    if (region.area() > 0)
+        demosaicRegion(frame_, (region + search_origin_) & search_rect);
+    else
+        demosaicRegion(frame_, search_rect);
+}
+
+cv::Rect PositionDetector::sourceROI() const
+{
+    return frame_source_.parameters().roi;
+}
+
+cv::Mat PositionDetector::searchRegion(oat::Frame &frame) const
+{
+    // Upstream components (e.g. a rectangular mask) may guarantee that
+    // pixels outside a region are zero, so skip them
+    const cv::Rect roi = sourceROI();
+    cv::Mat region = frame;
+    if (roi.area() > 0)
+        region = region(roi);
+
+    return region;
+}
+
+int PositionDetector::process()
+{
+    oat::Position2D internal_pos("");
+
+    if (!pullFrame(frame_))
+        return 1;
+
+    const cv::Rect roi = sourceROI();
+    cv::Mat search_frame = searchRegion(frame_);
+    search_origin_ = roi.area() > 0 ? roi.tl() : cv::Point(0, 0);
+    search_size_ = search_frame.size();
+
     // Propagate sample info and detect position
-    internal_pos.set_sample(internal_frame.sample());
-    detectPosition(internal_frame, internal_pos);
+    internal_pos.set_sample(frame_.sample());
+    if (tracking_on_)
+        trackPosition(search_frame, internal_pos);
+    else
+        searchFrame(search_frame, internal_pos);
+
+    if (partialSearch())
+        tuneSearch(search_frame, internal_pos);
+
+    if (internal_pos.position_valid) {
+        internal_pos.position.x += roi.x;
+        internal_pos.position.y += roi.y;
+    }
+
+    orientHeading(internal_pos, heading_history_, heading_min_speed_);
 
     // START CRITICAL SECTION //
     ////////////////////////////
@@ -98,4 +277,153 @@ int PositionDetector::process()
     return 0;
 }
 
+void PositionDetector::trackPosition(cv::Mat &frame, oat::Position2D &position)
+{
+    if (track_locked_) {
+
+        const cv::Rect roi = trackingWindow(frame.size());
+        if (roi.area() > 0) {
+
+            // Header only, no copy
+            demosaicSearch(roi);
+            cv::Mat window = frame(roi);
+            detectPosition(window, position);
+
+            if (position.position_valid) {
+                position.position.x += roi.x;
+                position.position.y += roi.y;
+                updateTrack(position);
+                return;
+            }
+        }
+
+        if (++track_misses_ < max_track_misses_)
+            return;
+
+        // Lost the object
+        track_locked_ = false;
+    }
+
+    searchFrame(frame, position);
+    if (position.position_valid)
+        updateTrack(position);
+}
+
+cv::Rect PositionDetector::trackingWindow(const cv::Size &frame_size) const
+{
+    // Predict forward by the number of frames since the last hit
+    const double steps = track_misses_ + 1;
+    const oat::Point2D center = track_position_ + steps * track_velocity_;
+
+    // Window grows with each miss to reacquire erratic objects
+    const double radius = std::sqrt(object_area_ / PI);
+    const double half_w
+        = steps * (track_scale_ * radius + std::abs(track_velocity_.x)) + 8.0;
+    const double half_h
+        = steps * (track_scale_ * radius + std::abs(track_velocity_.y)) + 8.0;
+
+    const cv::Rect window(cv::Point(std::floor(center.x - half_w),
+                                    std::floor(center.y - half_h)),
+                          cv::Point(std::ceil(center.x + half_w),
+                                    std::ceil(center.y + half_h)));
+
+    return window & cv::Rect(cv::Point(0, 0), frame_size);
+}
+
+void PositionDetector::searchFrame(cv::Mat &frame, oat::Position2D &position)
+{
+    demosaicSearch(cv::Rect());
+
+    if (pyramid_levels_ == 0) {
+        detectPosition(frame, position);
+        return;
+    }
+
+    // Subsample without filtering: cheaper than pyrDown and does not mix
+    // colors across object edges. Coarse pixel i samples source pixel
+    // i * scale + phase, the middle of its block, so coarse coordinates map
+    // back without a half-block bias. The scale factors are passed instead
+    // of a size so that the sampling step is exactly scale.
+    const int scale = 1 << pyramid_levels_;
+    const int phase = scale / 2;
+    const cv::Mat sampled = frame(cv::Rect(
+        phase, phase, frame.cols - phase, frame.rows - phase));
+    cv::resize(sampled,
+               coarse_frame_,
+               cv::Size(),
+               1.0 / scale,
+               1.0 / scale,
+               cv::INTER_NEAREST);
+
+    area_scale_ = 1.0 / (scale * scale);
+    search_scale_ = scale;
+    detectPosition(coarse_frame_, position);
+    area_scale_ = 1.0;
+    search_scale_ = 1;
+
+    if (!position.position_valid)
+        return;
+
+    const oat::Point2D coarse_position(position.position.x * scale + phase,
+                                       position.position.y * scale + phase);
+    const double coarse_area = object_area_ * scale * scale;
+
+    // Refinement window covers the object and the subsampling uncertainty
+    const double half
+        = 2.0 * std::sqrt(coarse_area / PI) + 2.0 * scale;
+    const cv::Rect roi
+        = cv::Rect(cv::Point(std::floor(coarse_position.x - half),
+                             std::floor(coarse_position.y - half)),
+                   cv::Point(std::ceil(coarse_position.x + half),
+                             std::ceil(coarse_position.y + half)))
+          & cv::Rect(cv::Point(0, 0), frame.size());
+
+    if (roi.area() > 0) {
+
+        // Header only, no copy
+        cv::Mat window = frame(roi);
+        detectPosition(window, position);
+
+        if (position.position_valid) {
+            position.position.x += roi.x;
+            position.position.y += roi.y;
+            return;
+        }
+    }
+
+    // Refinement failed, e.g. object is larger than the window after
+    // morphology. Fall back to the coarse estimate.
+    position.position = coarse_position;
+    position.position_valid = true;
+    object_area_ = coarse_area;
+}
+
+cv::Mat PositionDetector::searchElement(const cv::Mat &element) const
+{
+    if (search_scale_ == 1 || element.empty())
+        return element;
+
+    const int w = (element.cols + search_scale_ / 2) / search_scale_;
+    const int h = (element.rows + search_scale_ / 2) / search_scale_;
+    if (w <= 1 && h <= 1)
+        return cv::Mat();
+
+    return cv::getStructuringElement(
+        cv::MORPH_RECT, cv::Size(std::max(w, 1), std::max(h, 1)));
+}
+
+void PositionDetector::updateTrack(const oat::Position2D &position)
+{
+    // Velocity, in pixels per frame, is only meaningful between hits
+    if (track_locked_)
+        track_velocity_
+            = (position.position - track_position_) * (1.0 / (track_misses_ + 1));
+    else
+        track_velocity_ = oat::Velocity2D(0, 0);
+
+    track_position_ = position.position;
+    track_misses_ = 0;
+    track_locked_ = true;
+}
+
 } /* namespace oat */
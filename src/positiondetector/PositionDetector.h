@@ -33,6 +33,8 @@
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
+#include "DetectorFunc.h"
+
 namespace po = boost::program_options;
 
 namespace oat {
@@ -58,11 +60,18 @@ public:
 
 protected:
     /**
-     * Perform object position detection.
+     * Perform object position detection. Called by process() for each frame.
+     * Detectors that override process() to publish to more than one sink
+     * (e.g. MultiBandHSVDetector) have no single position to return and do
+     * not implement this. The default throws.
      * @param Frame to look for object within.
      * @param position Detected object position.
      */
-    virtual void detectPosition(cv::Mat &frame, oat::Position2D &position) = 0;
+    virtual void detectPosition(cv::Mat &frame, oat::Position2D &position);
+
+    // Current frame. Detectors that override process() should pull into this
+    // too, so that its buffer is reused between frames.
+    oat::Frame frame_;
 
     // Detector name
     const std::string name_;
@@ -70,6 +79,148 @@ protected:
     // Explicit frame data type
     oat::PixelColor required_color_ {PIX_BGR};
 
+    // Area of the most recently detected object. Set by detectPosition()
+    // and used to size the tracking window.
+    double object_area_ {0.0};
+
+    // Pixel area of the frame passed to detectPosition() relative to the
+    // source frame. Less than 1 during a coarse pyramid search, so object
+    // area bounds given in source pixels must be multiplied by it.
+    double area_scale_ {1.0};
+
+    // Linear subsampling of the frame passed to detectPosition() relative to
+    // the source frame. Greater than 1 during a coarse pyramid search.
+    int search_scale_ {1};
+
+    /**
+     * @brief Scale a rectangular morphology element, sized in source pixels,
+     * to the frame passed to detectPosition(). Without this, a coarse
+     * pyramid search would erode away or merge objects that a full
+     * resolution search keeps separate.
+     * @param element Structuring element at source resolution.
+     * @return Element to use. Empty if it vanishes at the current scale.
+     */
+    cv::Mat searchElement(const cv::Mat &element) const;
+
+    /**
+     * @brief Check if detectPosition() may be given windows or subsampled
+     * frames instead of the whole search frame, i.e. if tracking or pyramid
+     * search is on. Detectors must then not show tuning output from
+     * detectPosition() and should override tuneSearch() instead.
+     * @return True if searches are windowed or subsampled.
+     */
+    bool partialSearch(void) const { return tracking_on_ || pyramid_levels_ > 0; }
+
+    /**
+     * @brief Show tuning output for a completed search. Called once per frame
+     * on the whole search frame when partialSearch() is true. Raw Bayer
+     * frames may only be demosaiced within the searched windows, so
+     * overrides must call demosaicSearch() before reading the frame.
+     * @param frame Whole search frame.
+     * @param position Detected object position.
+     */
+    virtual void tuneSearch(cv::Mat &frame, const oat::Position2D &position) { }
+
+    /**
+     * @brief Append region of interest tracking options. Detectors whose
+     * detectPosition() is stateless across frames can offer tracking by
+     * calling this from options().
+     * @param opts Options to append to.
+     */
+    void appendTrackingOptions(po::options_description &opts) const;
+
+    /**
+     * @brief Apply region of interest tracking options.
+     * @param vm Pre-parse program option map.
+     * @param config_table Parsed TOML options table.
+     */
+    void applyTrackingConfiguration(const po::variables_map &vm,
+                                    const config::OptionTable &config_table);
+
+    /**
+     * @brief Append coarse-to-fine search options. Detectors that scale their
+     * object area bounds by area_scale_ can offer this by calling this from
+     * options().
+     * @param opts Options to append to.
+     */
+    void appendPyramidOptions(po::options_description &opts) const;
+
+    /**
+     * @brief Apply coarse-to-fine search options.
+     * @param vm Pre-parse program option map.
+     * @param config_table Parsed TOML options table.
+     */
+    void applyPyramidConfiguration(const po::variables_map &vm,
+                                   const config::OptionTable &config_table);
+
+    /**
+     * @brief Append heading options. Detectors that find objects using
+     * siftContours() report heading along the object's major axis and can
+     * offer control of its orientation by calling this from options().
+     * @param opts Options to append to.
+     */
+    void appendHeadingOptions(po::options_description &opts) const;
+
+    /**
+     * @brief Apply heading options.
+     * @param vm Pre-parse program option map.
+     * @param config_table Parsed TOML options table.
+     */
+    void applyHeadingConfiguration(const po::variables_map &vm,
+                                   const config::OptionTable &config_table);
+
+    // Minimum speed, in pixels per frame, at which heading is pointed along
+    // velocity instead of kept consistent with the previous heading
+    double heading_min_speed_ {1.0};
+
+    /**
+     * @brief Connect to the frame source. Detectors that publish something
+     * other than a single position override connectToNode() and use this
+     * to share the base class' frame handling.
+     * @return False if the connection could not be established.
+     */
+    bool connectToSource(void);
+
+    /**
+     * @brief Wait for the next source frame and copy it out of shared memory.
+     * Raw Bayer frames are not interpolated here: call demosaicRegion() on
+     * the returned frame before reading its pixels.
+     * @param frame Copied frame.
+     * @return False if the source has reached END.
+     */
+    bool pullFrame(oat::Frame &frame);
+
+    /**
+     * @brief Demosaic a region of the frame most recently returned by
+     * pullFrame(). Does nothing if the source does not provide raw Bayer
+     * frames or if the region has already been demosaiced.
+     * @param frame Frame returned by pullFrame().
+     * @param region Region of frame to demosaic. An empty rectangle indicates
+     * the whole frame.
+     */
+    void demosaicRegion(oat::Frame &frame, cv::Rect region);
+
+    /**
+     * @brief Demosaic a region of the frame being searched by process(), e.g.
+     * before showing all of it from tuneSearch().
+     * @param region Region of the search frame to demosaic. An empty
+     * rectangle indicates the whole search frame.
+     */
+    void demosaicSearch(const cv::Rect &region);
+
+    /**
+     * @brief Region of source frames that can contain non-zero pixels.
+     * @return Region of interest. Empty indicates the whole frame.
+     */
+    cv::Rect sourceROI(void) const;
+
+    /**
+     * @brief Crop a frame to sourceROI().
+     * @param frame Frame returned by pullFrame().
+     * @return Header for the region of frame to search. No data is copied.
+     */
+    cv::Mat searchRegion(oat::Frame &frame) const;
+
     // List of allowed configuration options
     //std::vector<std::string> config_keys_;
 
@@ -78,13 +229,49 @@ private:
     virtual bool connectToNode(void) override;
     int process(void) override;
 
-    // Current frame
+    // Offset of the searched region within the current frame
+    cv::Point search_origin_;
+    cv::Size search_size_;
+
+    // Current position
     oat::Position2D * shared_position_;
 
+    // Region of interest tracking. When the object is locked, only a window
+    // around its predicted position, sized by its area and velocity, is
+    // searched. After max_track_misses_ consecutive misses, the whole frame is
+    // searched again.
+    bool tracking_on_ {false};
+    double track_scale_ {4.0};
+    int max_track_misses_ {5};
+    int track_misses_ {0};
+    bool track_locked_ {false};
+    oat::Point2D track_position_;
+    oat::Velocity2D track_velocity_;
+    void trackPosition(cv::Mat &frame, oat::Position2D &position);
+    cv::Rect trackingWindow(const cv::Size &frame_size) const;
+    void updateTrack(const oat::Position2D &position);
+
+    // Coarse-to-fine search. The whole frame is searched after subsampling by
+    // 2^pyramid_levels_, and the hit is then refined at full resolution
+    // within a window around it.
+    int pyramid_levels_ {0};
+    cv::Mat coarse_frame_;
+    void searchFrame(cv::Mat &frame, oat::Position2D &position);
+
+    // Head/tail disambiguation of detected headings
+    oat::HeadingHistory heading_history_;
+
     // Frame source
     const std::string frame_source_address_;
     oat::Source<oat::Frame> frame_source_;
 
+    // Source provides raw Bayer frames that must be demosaiced to
+    // required_color_. Only the searched regions are interpolated, so a
+    // tracked object in a large stream costs only its window.
+    bool demosaic_ {false};
+    cv::Mat raw_frame_;
+    cv::Rect demosaiced_;
+
     // Position sink
     const std::string position_sink_address_;
     oat::Sink<oat::Position2D> position_sink_;
@@ -27,6 +27,7 @@
 
 #include "../../lib/datatypes/Position2D.h"
 #include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/ParallelRows.h"
 #include "../../lib/utility/TOMLSanitize.h"
 
 namespace oat {
@@ -65,6 +66,11 @@ po::options_description SimpleThreshold::options() const
          "If true, provide a GUI with sliders for tuning detection parameters.")
         ;
 
+    appendTrackingOptions(local_opts);
+    appendPyramidOptions(local_opts);
+    appendHeadingOptions(local_opts);
+    appendThreadOptions(local_opts);
+
     return local_opts;
 }
 
@@ -109,30 +115,62 @@ void SimpleThreshold::applyConfiguration(
 
     // Tuning GUI
     oat::config::getValue<bool>(vm, config_table, "tune", tuning_on_);
+
+    // Region of interest tracking
+    applyTrackingConfiguration(vm, config_table);
+
+    // Coarse-to-fine search
+    applyPyramidConfiguration(vm, config_table);
+
+    // Heading
+    applyHeadingConfiguration(vm, config_table);
+
+    // Worker threads
+    applyThreadConfiguration(vm, config_table);
 }
 
 void SimpleThreshold::detectPosition(cv::Mat &frame, oat::Position2D &position)
 {
-    if (tuning_on_)
+    // Windowed and subsampled searches are shown by tuneSearch()
+    const bool tune_here = tuning_on_ && !partialSearch();
+
+    if (tune_here)
         tune_frame_ = frame.clone();
 
     applyThreshold(frame);
 
     // Threshold frame will be destroyed by the transform below, so we need to use
     // it to form the frame that will be shown in the tuning window here
-    if (tuning_on_)
+    if (tune_here)
          tune_frame_.setTo(0, threshold_frame_ == 0);
 
     siftContours(threshold_frame_,
                  position,
                  object_area_,
-                 min_object_area_,
-                 max_object_area_);
+                 min_object_area_ * area_scale_,
+                 max_object_area_ * area_scale_);
 
-    if (tuning_on_)
+    if (tune_here)
         tune(tune_frame_, position);
 }
 
+void SimpleThreshold::tuneSearch(cv::Mat &frame,
+                                 const oat::Position2D &position)
+{
+    if (!tuning_on_)
+        return;
+
+    // Searches may only have demosaiced the window they looked in
+    demosaicSearch(cv::Rect());
+
+    // Threshold the whole frame so that the view does not depend on which
+    // window or pyramid level the object was found in
+    tune_frame_ = frame.clone();
+    applyThreshold(frame);
+    tune_frame_.setTo(0, threshold_frame_ == 0);
+    tune(tune_frame_, position);
+}
+
 void SimpleThreshold::tune(cv::Mat &frame, const oat::Position2D &position)
 {
     if (!tuning_windows_created_)
@@ -168,17 +206,12 @@ void SimpleThreshold::tune(cv::Mat &frame, const oat::Position2D &position)
 
 void SimpleThreshold::applyThreshold(cv::Mat &frame)
 {
-    cv::inRange(frame,
-                t_min_,
-                t_max_,
-                threshold_frame_);
-
-    // Filter the resulting threshold image
-    if (erode_on_)
-        cv::erode(threshold_frame_, threshold_frame_, erode_element_);
-
-    if (dilate_on_)
-        cv::dilate(threshold_frame_, threshold_frame_, dilate_element_);
+    thresholdMorph(frame,
+                   cv::Scalar(t_min_),
+                   cv::Scalar(t_max_),
+                   erode_on_ ? searchElement(erode_element_) : cv::Mat(),
+                   dilate_on_ ? searchElement(dilate_element_) : cv::Mat(),
+                   threshold_frame_);
 }
 
 void SimpleThreshold::createTuningWindows()
@@ -59,13 +59,11 @@ private:
                             const config::OptionTable &config_table) override;
 
     void detectPosition(cv::Mat &frame, oat::Position2D &position) override;
+    void tuneSearch(cv::Mat &frame, const oat::Position2D &position) override;
 
     // Intermediate variables
     cv::Mat threshold_frame_;
 
-    // Object detection
-    double object_area_ {0.0};
-
     // Sizes of the erode and dilate blocks
     int erode_px_ {0}, dilate_px_ {0};
     bool erode_on_ {false}, dilate_on_ {false};
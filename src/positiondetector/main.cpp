@@ -34,6 +34,9 @@
 #include "PositionDetector.h"
 #include "DifferenceDetector.h"
 #include "HSVDetector.h"
+#include "MultiHSVDetector.h"
+#include "MultiBandHSVDetector.h"
+#include "BGRLUTDetector.h"
 #include "SimpleThreshold.h"
 
 #define REQ_POSITIONAL_ARGS 3
@@ -44,7 +47,10 @@ const char usage_type[] =
     "TYPE\n"
     "  diff: Difference detector (color or grey-scale, motion)\n"
     "  hsv: HSV color thresholds (color)\n"
-    "  thresh: Simple amplitude threshold (mono)";
+    "  thresh: Simple amplitude threshold (mono)\n"
+    "  multi: HSV color thresholds, all objects (color, multi-position)\n"
+    "  bands: Several HSV color thresholds in one pass (color)\n"
+    "  lut: HSV color thresholds applied to BGR via lookup table (color)";
 
 const char usage_io[] =
     "SOURCE:\n"
@@ -93,6 +99,9 @@ int main(int argc, char *argv[])
     type_hash["diff"] = 'a';
     type_hash["hsv"] = 'b';
     type_hash["thresh"] = 'c';
+    type_hash["multi"] = 'd';
+    type_hash["bands"] = 'e';
+    type_hash["lut"] = 'f';
 
     // The component itself
     std::string comp_name = "posidet";
@@ -167,6 +176,21 @@ int main(int argc, char *argv[])
                     detector = std::make_shared<oat::SimpleThreshold>(source, sink);
                     break;
                 }
+                case 'd':
+                {
+                    detector = std::make_shared<oat::MultiHSVDetector>(source, sink);
+                    break;
+                }
+                case 'e':
+                {
+                    detector = std::make_shared<oat::MultiBandHSVDetector>(source, sink);
+                    break;
+                }
+                case 'f':
+                {
+                    detector = std::make_shared<oat::BGRLUTDetector>(source, sink);
+                    break;
+                }
                 default:
                 {
                     printUsage(visible_options, "");
@@ -0,0 +1,177 @@
+//******************************************************************************
+//* File:   FixedLagSmoother2D.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include <string>
+#include <cpptoml.h>
+
+#include "../../lib/utility/TOMLSanitize.h"
+
+#include "FixedLagSmoother2D.h"
+
+namespace oat {
+
+po::options_description FixedLagSmoother2D::options() const
+{
+    // Update CLI options
+    po::options_description local_opts;
+    local_opts.add_options()
+        ("lag,L", po::value<int>(),
+         "Number of samples by which the output is delayed. Each output "
+         "position is smoothed using this many later positions. Defaults "
+         "to 5.")
+        ("dt", po::value<double>(),
+         "Time step in seconds used when sample timestamps do not advance. "
+         "Defaults to the SOURCE's sample period.")
+        ("timeout,T", po::value<double>(),
+         "Seconds to perform position estimation detection with lack of "
+         "position measure. Defaults to 0.")
+        ("sigma-accel,a", po::value<double>(),
+         "Standard deviation of normally distributed, random accelerations used "
+         "by the internal model of object motion (position units/s2; e.g. "
+         "pixels/s2).")
+        ("sigma-noise,n", po::value<double>(),
+         "Standard deviation of randomly distributed position measurement noise "
+         "(position units; e.g. pixels).")
+        ;
+
+    return local_opts;
+}
+
+void FixedLagSmoother2D::applyConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Lag
+    oat::config::getNumericValue<int>(vm, config_table, "lag", lag_, 1);
+
+    // Fallback time step
+    oat::config::getNumericValue<double>(vm, config_table, "dt", dt_, 0);
+
+    // Blind filter timeout
+    oat::config::getNumericValue<double>(
+        vm, config_table, "timeout", timeout_, 0);
+
+    // Sigma accel
+    oat::config::getNumericValue<double>(
+        vm, config_table, "sigma-accel", sig_accel_, 0);
+
+    // Sigma noise
+    oat::config::getNumericValue<double>(
+        vm, config_table, "sigma-noise", sig_measure_noise_, 0);
+
+    // All per-sample state is allocated here
+    ring_.resize(lag_ + 1);
+}
+
+void FixedLagSmoother2D::filter(oat::Position2D &position)
+{
+    const double dt = timeStep(position.sample());
+
+    // Forward pass: Kalman filter the new position into the oldest slot
+    Step &s = ring_[head_];
+    s.position = position;
+    s.restart = false;
+
+    KF::State G;
+    KF::model(dt, s.F, G);
+
+    const double z[2] {position.position.x, position.position.y};
+    const double r = sig_measure_noise_ * sig_measure_noise_;
+
+    if (position.position_valid) {
+
+        for (int i = 0; i < 2; i++) {
+            if (found_) {
+                axes_[i].predict(dt, sig_accel_);
+                s.x_p[i] = axes_[i].state();
+                s.P_p[i] = axes_[i].covariance();
+                axes_[i].correct(z[i], r);
+            } else {
+                axes_[i].reset(z[i], 1000.0);
+            }
+        }
+
+        s.restart = !found_;
+        found_ = true;
+        time_lost_ = 0.0;
+
+    } else if (found_) {
+
+        time_lost_ += dt;
+        if (time_lost_ > timeout_) {
+            found_ = false;
+        } else {
+            for (int i = 0; i < 2; i++) {
+                axes_[i].predict(dt, sig_accel_);
+                s.x_p[i] = axes_[i].state();
+                s.P_p[i] = axes_[i].covariance();
+            }
+        }
+    }
+
+    s.valid = found_;
+    for (int i = 0; i < 2; i++) {
+        s.x_f[i] = axes_[i].state();
+        s.P_f[i] = axes_[i].covariance();
+    }
+
+    const size_t n = ring_.size();
+    head_ = (head_ + 1) % n;
+    if (filled_ < n)
+        filled_++;
+
+    if (!outputReady())
+        return;
+
+    // Backward pass: RTS recursion from the newest step to the oldest. The
+    // recursion restarts at any step the filter was not continuously
+    // tracking across.
+    KF::State x_s[2];
+    size_t k = (head_ + n - 1) % n;
+    for (int i = 0; i < 2; i++)
+        x_s[i] = ring_[k].x_f[i];
+
+    while (k != head_) {
+
+        const Step &next = ring_[k];
+        k = (k + n - 1) % n;
+        const Step &prev = ring_[k];
+
+        for (int i = 0; i < 2; i++) {
+            if (next.restart || !next.valid || !prev.valid) {
+                x_s[i] = prev.x_f[i];
+            } else {
+                const KF::Covariance C
+                    = prev.P_f[i] * next.F.t() * next.P_p[i].inv();
+                x_s[i] = prev.x_f[i] + C * (x_s[i] - next.x_p[i]);
+            }
+        }
+    }
+
+    // Publish the oldest position, with its own sample info
+    const Step &out = ring_[head_];
+    position = out.position;
+    position.position.x = x_s[0](0);
+    position.velocity.x = x_s[0](1);
+    position.position.y = x_s[1](0);
+    position.velocity.y = x_s[1](1);
+    position.position_valid = out.valid;
+    position.velocity_valid = out.valid;
+}
+
+} /* namespace oat */
@@ -0,0 +1,97 @@
+//******************************************************************************
+//* File:   FixedLagSmoother2D.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_FIXEDLAGSMOOTHER2D_H
+#define	OAT_FIXEDLAGSMOOTHER2D_H
+
+#include "PositionFilter.h"
+#include "KinematicKalman.h"
+
+#include <string>
+#include <vector>
+
+namespace oat {
+
+class FixedLagSmoother2D : public PositionFilter {
+
+public:
+    /**
+     * A 2D fixed-lag Rauch-Tung-Striebel smoother.
+     * Positions are Kalman filtered using a constant velocity model and the
+     * last lag + 1 filtered states are kept. Each time a position arrives, a
+     * backward pass over these states produces the smoothed estimate of the
+     * position received lag samples earlier, which is then published with
+     * that position's sample number and timestamp.
+     * @param position_source_address Un-filtered position SOURCE name
+     * @param position_sink_address Smoothed position SINK name
+     */
+    using PositionFilter::PositionFilter;
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    using KF = oat::KinematicKalman<2>;
+
+    // Filter state at one sample
+    struct Step {
+        oat::Position2D position;       //!< Position as received
+        KF::State x_f[2], x_p[2];       //!< Filtered and predicted states
+        KF::Covariance P_f[2], P_p[2];  //!< Filtered and predicted covariances
+        KF::Covariance F;               //!< Transition from previous sample
+        bool valid {false};             //!< Filter was tracking
+        bool restart {false};           //!< Filter was reset at this sample
+    };
+
+    // Ring of the last lag_ + 1 steps. head_ indexes the oldest, which is the
+    // next to be published and overwritten.
+    int lag_ {5};
+    std::vector<Step> ring_;
+    size_t head_ {0};
+    size_t filled_ {0};
+
+    // Forward filter, one per axis
+    KF axes_[2];
+
+    // Standard deviation of assumed random accelerations and measurement
+    // noise
+    double sig_accel_ {5.0};
+    double sig_measure_noise_ {0.0};
+
+    // Variables and parameters to control whether or not to apply the filter
+    bool found_ {false};
+    double time_lost_ {0.0};
+    double timeout_ {0.0};
+
+    /**
+     * Filter the incoming position and replace it with the smoothed position
+     * from lag samples earlier.
+     * @param position Position to filter
+     */
+    void filter(oat::Position2D& position) override;
+    bool outputReady(void) const override
+    {
+        return !ring_.empty() && filled_ == ring_.size();
+    }
+};
+
+}      /* namespace oat */
+#endif /* OAT_FIXEDLAGSMOOTHER2D_H */
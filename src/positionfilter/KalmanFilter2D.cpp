@@ -42,15 +42,27 @@ po::options_description KalmanFilter2D::options() const
     // Update CLI options
     po::options_description local_opts;
     local_opts.add_options()
-        ("dt", po::value<double>(), // TODO: should be automatic?
-         "Kalman filter time step in seconds.")
+        ("model,m", po::value<std::string>(),
+         "Motion model. 'cv' for constant velocity driven by random "
+         "accelerations or 'ca' for constant acceleration driven by random "
+         "jerks. Defaults to 'cv'.")
+        ("dt", po::value<double>(),
+         "Kalman filter time step in seconds. The time step is normally "
+         "measured between the timestamps of consecutive samples, which "
+         "accounts for dropped samples and variable sample rates. This value "
+         "is only used when timestamps do not advance. Defaults to the "
+         "SOURCE's sample period.")
         ("timeout,T", po::value<double>(),
          "Seconds to perform position estimation detection with lack of "
          "position measure. Defaults to 0.")
         ("sigma-accel,a", po::value<double>(), // TODO: Should be specified in each dimension
          "Standard deviation of normally distributed, random accelerations used "
-         "by the internal model of object motion (position units/s2; e.g. "
-         "pixels/s2).")
+         "by the constant velocity model of object motion (position "
+         "units/s2; e.g. pixels/s2).")
+        ("sigma-jerk,j", po::value<double>(),
+         "Standard deviation of normally distributed, random jerks used by "
+         "the constant acceleration model of object motion (position "
+         "units/s3; e.g. pixels/s3).")
         ("sigma-noise,n", po::value<double>(), // TODO: Should be specified in each dimension
          "Standard deviation of randomly distributed position measurement noise "
          "(position units; e.g. pixels).")
@@ -65,18 +77,30 @@ po::options_description KalmanFilter2D::options() const
 void KalmanFilter2D::applyConfiguration(const po::variables_map &vm,
                                         const config::OptionTable &config_table)
 {
-    // Time step
+    // Motion model
+    std::string model;
+    if (oat::config::getValue<std::string>(vm, config_table, "model", model)) {
+        if (model == "ca")
+            accel_model_ = true;
+        else if (model != "cv")
+            throw std::runtime_error("Kalman model must be 'cv' or 'ca'.");
+    }
+
+    // Fallback time step
     oat::config::getNumericValue<double>(vm, config_table, "dt", dt_, 0);
 
     // Blind filter timeout
-    double t;
-    if (oat::config::getNumericValue<double>(vm, config_table, "timeout", t, 0))
-        not_found_count_threshold_ = static_cast<int>(t / dt_);
+    oat::config::getNumericValue<double>(
+        vm, config_table, "timeout", timeout_, 0);
 
     // Sigma accel
     oat::config::getNumericValue<double>(
         vm, config_table, "sigma-accel", sig_accel_, 0);
 
+    // Sigma jerk
+    oat::config::getNumericValue<double>(
+        vm, config_table, "sigma-jerk", sig_jerk_, 0);
+
     // Sigma noise
     oat::config::getNumericValue<double>(
         vm, config_table, "sigma-noise", sig_measure_noise_, 0);
@@ -93,120 +117,65 @@ void KalmanFilter2D::applyConfiguration(const po::variables_map &vm,
 
 void KalmanFilter2D::filter(oat::Position2D &position) {
 
-    // Transform raw position into kf_meas_ vector
-    if (position.position_valid) {
-        kf_meas_(0,0) = position.position.x;
-        kf_meas_(1,0) = position.position.y;
-        not_found_count_ = 0;
-
-        // We are coming from a time step where there were no measurements for
-        // a long time, or the first sample, so we need to reinitialize the
-        // filter
-        if (!found_)
-            initializeFilter();
-
-        found_ = true;
-    } else {
-        not_found_count_++;
-    }
-
-    // If we have not gotten a measurement of the object for a long time
-    // we need to reinitialize the filter
-    if (not_found_count_ >= not_found_count_threshold_)
-        found_ = false;
-
-    // Only update if the object is found_ (this includes time points for which
-    // the position measurement was invalid, but we are within the not_found_count_threshold_)
-    if (found_) {
+    const double dt = timeStep(position.sample());
 
-        kf_predicted_state_ = kf_.predict();
-
-        // Apply the Kalman update
-        kf_.correct(kf_meas_);
-    }
-
-    position.position.x = kf_predicted_state_(0, 0);
-    position.velocity.x = kf_predicted_state_(1, 0);
-    position.position.y = kf_predicted_state_(2, 0);
-    position.velocity.y = kf_predicted_state_(3, 0);
-
-    // This Position is only valid if the not_found_count_threshold_ has not
-    // be exceeded
-    if (found_) {
-        position.position_valid = true;
-        position.velocity_valid = true;
-    } else {
-        position.position_valid = false;
-        position.velocity_valid = false;
-    }
+    if (accel_model_)
+        step(ca_axes_, sig_jerk_, dt, position);
+    else
+        step(cv_axes_, sig_accel_, dt, position);
 
     // Tune the filter, if requested
     tune();
 }
 
-void KalmanFilter2D::initializeFilter(void) {
+template <int N>
+void KalmanFilter2D::step(oat::KinematicKalman<N> (&axes)[2],
+                          double sigma,
+                          double dt,
+                          oat::Position2D &position)
+{
+    const double z[2] {position.position.x, position.position.y};
 
-    initializeStaticMatracies();
+    if (position.position_valid) {
 
-    // Error covariance matrix (initialize with large value to indicate a lack
-    // of trust in the model)
-    cv::setIdentity(kf_.errorCovPre, 1000.0);
+        // We are coming from a time step where there were no measurements for
+        // a long time, or the first sample, so we need to reinitialize the
+        // filter. Initialize error covariance with large value to indicate a
+        // lack of trust in the model.
+        const double r = sig_measure_noise_ * sig_measure_noise_;
+        for (int i = 0; i < 2; i++) {
+            if (found_) {
+                axes[i].predict(dt, sigma);
+                axes[i].correct(z[i], r);
+            } else {
+                axes[i].reset(z[i], 1000.0);
+            }
+        }
 
-    // TODO: Add head direction?
-    // The state is
-    // [ x  x'  y  y']^T, where ' denotes the time derivative
-    // Initialize the pre/post state using the current measurement
-    kf_.statePre.at<double>(0) = kf_meas_(0, 0);
-    kf_.statePre.at<double>(1) = 0.0;
-    kf_.statePre.at<double>(2) = kf_meas_(1, 0);
-    kf_.statePre.at<double>(3) = 0.0;
+        found_ = true;
+        time_lost_ = 0.0;
+
+    } else if (found_) {
+
+        // If we have not gotten a measurement of the object for a long time
+        // we need to reinitialize the filter. Otherwise, coast.
+        time_lost_ += dt;
+        if (time_lost_ > timeout_) {
+            found_ = false;
+        } else {
+            for (auto &a : axes)
+                a.predict(dt, sigma);
+        }
+    }
 
-    kf_.statePost.at<double>(0) = kf_meas_(0, 0);
-    kf_.statePost.at<double>(1) = 0.0;
-    kf_.statePost.at<double>(2) = kf_meas_(1, 0);
-    kf_.statePost.at<double>(3) = 0.0;
-}
+    position.position.x = axes[0].state()(0);
+    position.velocity.x = axes[0].state()(1);
+    position.position.y = axes[1].state()(0);
+    position.velocity.y = axes[1].state()(1);
 
-void KalmanFilter2D::initializeStaticMatracies() {
-
-    // State transition matrix
-    // [ 1  dt_ 0  0  ]
-    // [ 0  1  0  0   ]
-    // [ 0  0  1  dt_ ]
-    // [ 0  0  0  1   ]
-    cv::setIdentity(kf_.transitionMatrix);
-    kf_.transitionMatrix.at<double>(0, 1) = dt_;
-    kf_.transitionMatrix.at<double>(2, 3) = dt_;
-
-    // Observation Matrix (can only see position directly)
-    // [ 1  0  0  0 ]
-    // [ 0  0  1  0 ]
-    kf_.measurementMatrix = cv::Mat::zeros(2, 4, CV_64F);
-    kf_.measurementMatrix.at<double>(0, 0) = 1.0;
-    kf_.measurementMatrix.at<double>(1, 2) = 1.0;
-
-    // Noise covariance matrix (see pp13-15 of MWL.JPN.105.02.002 for derivation)
-    // [ dt_^4/4 dt_^3/2 		       ]
-    // [ dt_^3/2 dt_^2   		       ]
-    // [               dt_^4/2 dt_^2/3 ] * sigma_accel^2
-    // [               dt_^2/3 dt_^2   ]
-    kf_.processNoiseCov = cv::Mat::zeros(4, 4, CV_64F);
-    kf_.processNoiseCov.at<double>(0, 0) = sig_accel_ * sig_accel_ * (dt_ * dt_ * dt_ * dt_) / 4.0;
-    kf_.processNoiseCov.at<double>(0, 1) = sig_accel_ * sig_accel_ * (dt_ * dt_ * dt_) / 2.0;
-
-    kf_.processNoiseCov.at<double>(1, 0) = sig_accel_ * sig_accel_ * (dt_ * dt_ * dt_) / 2.0;
-    kf_.processNoiseCov.at<double>(1, 1) = sig_accel_ * sig_accel_ * (dt_ * dt_);
-
-    kf_.processNoiseCov.at<double>(2, 2) = sig_accel_ * sig_accel_ * (dt_ * dt_ * dt_ * dt_) / 4.0;
-    kf_.processNoiseCov.at<double>(2, 3) = sig_accel_ * sig_accel_ * (dt_ * dt_ * dt_) / 2.0;
-
-    kf_.processNoiseCov.at<double>(3, 2) = sig_accel_ * sig_accel_ * (dt_ * dt_ * dt_) / 2.0;
-    kf_.processNoiseCov.at<double>(3, 3) = sig_accel_ * sig_accel_ * (dt_ * dt_);
-
-    // Measurement noise covariance
-    // [ sig_x^2  0 ]
-    // [ 0  sig_y^2 ]
-    cv::setIdentity(kf_.measurementNoiseCov, cv::Scalar(sig_measure_noise_ * sig_measure_noise_));
+    // This Position is only valid if the timeout has not been exceeded
+    position.position_valid = found_;
+    position.velocity_valid = found_;
 }
 
 void KalmanFilter2D::tune() {
@@ -223,7 +192,6 @@ void KalmanFilter2D::tune() {
         // Use the new parameters to create new static filter matracies
         sig_accel_ = static_cast<double>(sig_accel_tune_);
         sig_measure_noise_ = static_cast<double>(sig_measure_noise_tune_);
-        initializeStaticMatracies();
 
         //cv::Mat tuning_canvas(canvas_hw, canvas_hw, CV_8UC3);
         //tuning_canvas.setTo(255);
@@ -21,6 +21,7 @@
 #define	OAT_KALMANFILTER2D_H
 
 #include "PositionFilter.h"
+#include "KinematicKalman.h"
 
 #include <string>
 #include <opencv2/opencv.hpp>
@@ -35,9 +36,10 @@ public:
      * The assumed model is normally distributed constant force applied at each
      * time steps causes a random, constant acceleration in between each time-step.
      * Measurement noise is assumed to be Gaussian with a user supplied variance.
-     * Model parameters (time step size, standard deviation of random acceleration,
+     * Model parameters (standard deviation of random acceleration,
      * and measurement noise standard deviation, etc) are supplied using the
-     * configure method.
+     * configure method. The time step is measured from the position samples'
+     * timestamps.
      * @param position_source_address Un-filtered position SOURCE name
      * @param position_sink_address Filtered position SINK name
      */
@@ -50,15 +52,15 @@ private:
     void applyConfiguration(const po::variables_map &vm,
                             const config::OptionTable &config_table) override;
 
-    // Kalman state estimate and measurement vectors
-    cv::Mat_<double> kf_predicted_state_ {4, 1, CV_64F};
-    cv::Mat_<double> kf_meas_ {2, 1, CV_64F};
+    // Motion model. Axes are independent, so each has its own filter.
+    bool accel_model_ {false};
+    oat::KinematicKalman<2> cv_axes_[2];
+    oat::KinematicKalman<3> ca_axes_[2];
 
-    // Sample period
-    double dt_ {0.02};
-
-    // Standard deviation of assumed random accelerations.
+    // Standard deviation of assumed random accelerations (or jerks, for the
+    // constant acceleration model) and measurement noise
     double sig_accel_ {5.0};
+    double sig_jerk_ {50.0};
     double sig_measure_noise_ {0.0};
 
     // Parameter tuning
@@ -71,11 +73,8 @@ private:
 
     // Variables and parameters to control whether or not to apply the filter
     bool found_ {false};
-    int not_found_count_ {0};
-    int not_found_count_threshold_ {0};
-
-    // Kalman filter object
-    cv::KalmanFilter kf_ {4, 2, 0, CV_64F};
+    double time_lost_ {0.0};
+    double timeout_ {0.0};
 
     /**
      * Perform Kalman filtering.
@@ -83,10 +82,21 @@ private:
      */
     void filter(oat::Position2D& position) override;
 
+    /**
+     * Advance a motion model by one sample.
+     * @param axes Filters for the x and y axes.
+     * @param sigma Standard deviation of the model's driving noise.
+     * @param dt Time since the previous sample in seconds.
+     * @param position Position to filter
+     */
+    template <int N>
+    void step(oat::KinematicKalman<N> (&axes)[2],
+              double sigma,
+              double dt,
+              oat::Position2D &position);
+
     // Subroutines
     void tune(void);
-    void initializeFilter(void);
-    void initializeStaticMatracies(void);
     void createTuningWindows(void);
     //void drawPosition(cv::Mat& canvas, const oat::Position2D& position);
 };
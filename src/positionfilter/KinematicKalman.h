@@ -0,0 +1,120 @@
+//******************************************************************************
+//* File:   KinematicKalman.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_KINEMATICKALMAN_H
+#define	OAT_KINEMATICKALMAN_H
+
+#include <opencv2/core/matx.hpp>
+
+namespace oat {
+
+/**
+ * @brief Kalman filter for a single axis of a kinematic model whose state is
+ * position and its first N - 1 time derivatives. N = 2 is a constant
+ * velocity model and N = 3 is a constant acceleration model. The model is
+ * driven by white noise in the N'th derivative which is held constant over
+ * each interval. Only position is measured, so the innovation is scalar and
+ * no matrix inversion is required. All storage is fixed size, so filtering
+ * performs no heap allocation.
+ */
+template <int N>
+class KinematicKalman {
+
+    static_assert(N >= 2, "State must include at least one derivative.");
+
+public:
+    using State = cv::Matx<double, N, 1>;
+    using Covariance = cv::Matx<double, N, N>;
+
+    /**
+     * @brief Restart the filter at a measured position with all derivatives
+     * zero.
+     * @param z Measured position.
+     * @param var Initial variance of each state element. Use a large value to
+     * indicate a lack of trust in the initial state.
+     */
+    void reset(const double z, const double var)
+    {
+        x_ = State::zeros();
+        x_(0) = z;
+        P_ = Covariance::eye() * var;
+    }
+
+    /**
+     * @brief Model matrices for an interval: the Taylor series state
+     * transition, F(i, j) = dt^(j - i) / (j - i)!, and the gain of the driving
+     * noise, G(i) = dt^(N - i) / (N - i)!.
+     * @param dt Interval in seconds.
+     * @param F State transition.
+     * @param G Noise gain. Process noise covariance is sigma^2 G G^T.
+     */
+    static void model(const double dt, Covariance &F, State &G)
+    {
+        F = Covariance::eye();
+        double term = 1.0;
+        for (int k = 1; k <= N; k++) {
+            term *= dt / k;
+            for (int i = 0; i + k < N; i++)
+                F(i, i + k) = term;
+            G(N - k) = term;
+        }
+    }
+
+    /**
+     * @brief Propagate the state and its covariance over an interval.
+     * @param dt Interval in seconds.
+     * @param sigma Standard deviation of the N'th derivative.
+     */
+    void predict(const double dt, const double sigma)
+    {
+        Covariance F;
+        State G;
+        model(dt, F, G);
+
+        x_ = F * x_;
+        P_ = F * P_ * F.t() + (sigma * sigma) * (G * G.t());
+    }
+
+    /**
+     * @brief Incorporate a position measurement.
+     * @param z Measured position.
+     * @param r Measurement noise variance.
+     */
+    void correct(const double z, const double r)
+    {
+        const double s = P_(0, 0) + r;
+        if (s <= 0)
+            return;
+
+        const State K = P_.col(0) * (1.0 / s);
+        x_ += K * (z - x_(0));
+        P_ -= K * P_.row(0);
+    }
+
+    // Accessors
+    const State &state(void) const { return x_; }
+    const Covariance &covariance(void) const { return P_; }
+
+private:
+    State x_ {State::zeros()};
+    Covariance P_ {Covariance::eye()};
+};
+
+}      /* namespace oat */
+#endif /* OAT_KINEMATICKALMAN_H */
@@ -0,0 +1,166 @@
+//******************************************************************************
+//* File:   MultiTracker2D.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include <string>
+#include <cpptoml.h>
+
+#include "../../lib/utility/TOMLSanitize.h"
+#include "../../lib/utility/IOFormat.h"
+
+#include "MultiTracker2D.h"
+
+namespace oat {
+
+MultiTracker2D::MultiTracker2D(const std::string &positions_source_address,
+                               const std::string &positions_sink_address)
+: name_("posifilt[" + positions_source_address + "->" + positions_sink_address + "]")
+, positions_source_address_(positions_source_address)
+, positions_sink_address_(positions_sink_address)
+{
+    // Nothing
+}
+
+po::options_description MultiTracker2D::options() const
+{
+    // Update CLI options
+    po::options_description local_opts;
+    local_opts.add_options()
+        ("assign", po::value<std::string>(),
+         "Method used to assign detections to tracks. 'optimal' minimizes "
+         "the total distance between tracks and their assigned detections "
+         "using the Hungarian algorithm. 'nearest' greedily assigns the "
+         "closest track-detection pairs first. Defaults to 'optimal'.")
+        ("gate,g", po::value<double>(),
+         "Largest distance, in standard deviations of a track's predicted "
+         "position, at which a detection can be assigned to it. Defaults to "
+         "3.")
+        ("confirm-hits", po::value<int>(),
+         "Number of detections assigned to a new track before it is confirmed "
+         "and published. A new track is deleted if it misses before being "
+         "confirmed. Defaults to 3.")
+        ("max-misses", po::value<int>(),
+         "Number of consecutive samples a confirmed track can go without an "
+         "assigned detection before it is deleted. Its predicted position is "
+         "published in the meantime. Defaults to 5.")
+        ("dt", po::value<double>(),
+         "Kalman filter time step in seconds. The time step is normally "
+         "measured between the timestamps of consecutive samples. This value "
+         "is only used when timestamps do not advance. Defaults to the "
+         "SOURCE's sample period.")
+        ("sigma-accel,a", po::value<double>(),
+         "Standard deviation of normally distributed, random accelerations used "
+         "by the constant velocity model of each object's motion (position "
+         "units/s2; e.g. pixels/s2).")
+        ("sigma-noise,n", po::value<double>(),
+         "Standard deviation of randomly distributed position measurement noise "
+         "(position units; e.g. pixels). Defaults to 1.")
+        ;
+
+    return local_opts;
+}
+
+void MultiTracker2D::applyConfiguration(const po::variables_map &vm,
+                                        const config::OptionTable &config_table)
+{
+    // Assignment method
+    std::string assign;
+    if (oat::config::getValue<std::string>(vm, config_table, "assign", assign)) {
+        if (assign == "nearest")
+            tracks_.set_optimal(false);
+        else if (assign != "optimal")
+            throw std::runtime_error("assign must be 'optimal' or 'nearest'.");
+    }
+
+    // Track management
+    double gate = tracks_.gate();
+    int confirm_hits = tracks_.confirm_hits();
+    int max_misses = tracks_.max_misses();
+    oat::config::getNumericValue<double>(vm, config_table, "gate", gate, 0);
+    oat::config::getNumericValue<int>(
+        vm, config_table, "confirm-hits", confirm_hits, 1);
+    oat::config::getNumericValue<int>(
+        vm, config_table, "max-misses", max_misses, 0);
+    tracks_.set_gating(gate, confirm_hits, max_misses);
+
+    // Model
+    double sig_accel = tracks_.sigma_accel();
+    double sig_noise = tracks_.sigma_noise();
+    oat::config::getNumericValue<double>(vm, config_table, "dt", dt_, 0);
+    oat::config::getNumericValue<double>(
+        vm, config_table, "sigma-accel", sig_accel, 0);
+    oat::config::getNumericValue<double>(
+        vm, config_table, "sigma-noise", sig_noise, 0);
+    tracks_.set_model(sig_accel, sig_noise);
+}
+
+bool MultiTracker2D::connectToNode()
+{
+    // Establish our a slot in the node
+    positions_source_.touch(positions_source_address_);
+
+    // Wait for synchronous start with sink when it binds the node
+    if (positions_source_.connect() != SourceState::CONNECTED)
+        return false;
+
+    // Bind to sink node and create a shared position set
+    positions_sink_.bind(positions_sink_address_, positions_sink_address_);
+    shared_positions_ = positions_sink_.retrieve();
+
+    return true;
+}
+
+int MultiTracker2D::process()
+{
+    // START CRITICAL SECTION //
+    ////////////////////////////
+
+    // Wait for sink to write to node
+    if (positions_source_.wait() == oat::NodeState::END)
+        return 1;
+
+    detections_ = *positions_source_.retrieve();
+
+    // Tell sink it can continue
+    positions_source_.post();
+
+    ////////////////////////////
+    //  END CRITICAL SECTION  //
+
+    tracks_.update(detections_,
+                   oat::timeStep(detections_.sample(), dt_, last_time_),
+                   tracked_);
+
+    // START CRITICAL SECTION //
+    ////////////////////////////
+
+    // Wait for sources to read
+    positions_sink_.wait();
+
+    *shared_positions_ = tracked_;
+
+    // Tell sources there is new data
+    positions_sink_.post();
+
+    ////////////////////////////
+    //  END CRITICAL SECTION  //
+
+    return 0;
+}
+
+} /* namespace oat */
@@ -0,0 +1,91 @@
+//******************************************************************************
+//* File:   MultiTracker2D.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_MULTITRACKER2D_H
+#define	OAT_MULTITRACKER2D_H
+
+#include <string>
+
+#include <boost/program_options.hpp>
+
+#include "../../lib/base/Component.h"
+#include "../../lib/base/Configurable.h"
+#include "../../lib/datatypes/MultiPosition2D.h"
+#include "../../lib/shmemdf/Sink.h"
+#include "../../lib/shmemdf/Source.h"
+
+#include "TimeStep.h"
+#include "TrackSet.h"
+
+namespace po = boost::program_options;
+
+namespace oat {
+
+class MultiTracker2D : public Component, public Configurable<false> {
+
+public:
+    /**
+     * A multi-object tracker.
+     * Maintains a set of tracks (see TrackSet) from a multi-position stream,
+     * e.g. from a multi-object detector, and publishes confirmed tracks with
+     * stable IDs.
+     * @param positions_source_address Multi-position SOURCE name
+     * @param positions_sink_address Tracked multi-position SINK name
+     */
+    MultiTracker2D(const std::string &positions_source_address,
+                   const std::string &positions_sink_address);
+
+    // Component Interface
+    oat::ComponentType type(void) const override { return oat::positionfilter; };
+    std::string name(void) const override { return name_; }
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    // Component Interface
+    bool connectToNode(void) override;
+    int process(void) override;
+
+    // Filter name
+    const std::string name_;
+
+    // Tracks
+    oat::TrackSet tracks_;
+
+    // Time step used when it cannot be measured from sample timestamps. 0
+    // indicates the SOURCE's sample period.
+    double dt_ {0.0};
+    oat::SampleTime last_time_;
+
+    // Multi-position SOURCE and SINK
+    const std::string positions_source_address_;
+    oat::MultiPosition2D detections_ {""};
+    oat::Source<oat::MultiPosition2D> positions_source_;
+
+    const std::string positions_sink_address_;
+    oat::MultiPosition2D tracked_ {""};
+    oat::MultiPosition2D * shared_positions_ {nullptr};
+    oat::Sink<oat::MultiPosition2D> positions_sink_;
+};
+
+}      /* namespace oat */
+#endif /* OAT_MULTITRACKER2D_H */
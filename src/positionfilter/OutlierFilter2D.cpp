@@ -0,0 +1,148 @@
+//******************************************************************************
+//* File:   OutlierFilter2D.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include <cmath>
+#include <string>
+#include <cpptoml.h>
+#include <opencv2/core.hpp>
+
+#include "../../lib/utility/TOMLSanitize.h"
+
+#include "OutlierFilter2D.h"
+
+namespace oat {
+
+// Weight of the newest accepted displacement in the velocity estimate
+static constexpr double OUTLIER_VELOCITY_ALPHA {0.5};
+
+po::options_description OutlierFilter2D::options() const
+{
+    // Update CLI options
+    po::options_description local_opts;
+    local_opts.add_options()
+        ("max-speed,v", po::value<double>(),
+         "Maximum object speed (position units/s; e.g. pixels/s). Positions "
+         "farther from the last accepted position than the object could "
+         "travel at this speed are rejected. Defaults to 0 (disabled).")
+        ("max-accel,a", po::value<double>(),
+         "Maximum object acceleration (position units/s2; e.g. pixels/s2). "
+         "Positions farther from the last accepted position, extrapolated "
+         "using the object's velocity, than the object could deviate at "
+         "this acceleration are rejected. Defaults to 0 (disabled).")
+        ("tolerance,t", po::value<double>(),
+         "Distance added to each gate to allow for measurement noise "
+         "(position units; e.g. pixels). Defaults to 5.")
+        ("max-rejects,r", po::value<int>(),
+         "Number of consecutive rejected positions after which the next "
+         "position is accepted unconditionally and the filter is re-anchored "
+         "to it. Defaults to 5.")
+        ("dt", po::value<double>(),
+         "Time step in seconds used when sample timestamps do not advance. "
+         "Defaults to the SOURCE's sample period.")
+        ;
+
+    return local_opts;
+}
+
+void OutlierFilter2D::applyConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Gates
+    oat::config::getNumericValue<double>(
+        vm, config_table, "max-speed", max_speed_, 0);
+    oat::config::getNumericValue<double>(
+        vm, config_table, "max-accel", max_accel_, 0);
+    oat::config::getNumericValue<double>(
+        vm, config_table, "tolerance", tolerance_, 0);
+
+    if (max_speed_ <= 0 && max_accel_ <= 0)
+        throw std::runtime_error(
+            "At least one of max-speed and max-accel must be specified.");
+
+    // Re-anchoring
+    oat::config::getNumericValue<int>(
+        vm, config_table, "max-rejects", max_rejects_, 1);
+
+    // Fallback time step
+    oat::config::getNumericValue<double>(vm, config_table, "dt", dt_, 0);
+}
+
+bool OutlierFilter2D::plausible(const oat::Point2D &p, double dt) const
+{
+    if (max_speed_ > 0
+        && cv::norm(p - anchor_) > max_speed_ * dt + tolerance_)
+        return false;
+
+    if (max_accel_ > 0 && velocity_known_
+        && cv::norm(p - (anchor_ + velocity_ * dt))
+               > 0.5 * max_accel_ * dt * dt + tolerance_)
+        return false;
+
+    return true;
+}
+
+void OutlierFilter2D::filter(oat::Position2D &position)
+{
+    const double dt = timeStep(position.sample());
+
+    time_since_anchor_ += dt;
+
+    if (!position.position_valid) {
+
+        // Do not extrapolate a stale velocity across the gap. It is
+        // re-estimated from the next accepted position.
+        velocity_known_ = false;
+        return;
+    }
+
+    const double t = time_since_anchor_;
+    const bool jump = anchored_ && !plausible(position.position, t);
+
+    if (jump && rejects_ < max_rejects_) {
+
+        rejects_++;
+        position.position_valid = false;
+        position.velocity_valid = false;
+        position.heading_valid = false;
+        position.region_valid = false;
+        return;
+    }
+
+    // Velocity is measured across rejected samples, but not across a forced
+    // re-anchoring jump
+    if (anchored_ && !jump && t > 0) {
+
+        const oat::Velocity2D v = (position.position - anchor_) * (1.0 / t);
+        velocity_ = velocity_known_
+                        ? (1.0 - OUTLIER_VELOCITY_ALPHA) * velocity_
+                              + OUTLIER_VELOCITY_ALPHA * v
+                        : v;
+        velocity_known_ = true;
+
+    } else {
+        velocity_known_ = false;
+    }
+
+    anchor_ = position.position;
+    anchored_ = true;
+    time_since_anchor_ = 0.0;
+    rejects_ = 0;
+}
+
+} /* namespace oat */
@@ -0,0 +1,81 @@
+//******************************************************************************
+//* File:   OutlierFilter2D.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_OUTLIERFILTER2D_H
+#define	OAT_OUTLIERFILTER2D_H
+
+#include "PositionFilter.h"
+
+#include <string>
+
+namespace oat {
+
+class OutlierFilter2D : public PositionFilter {
+
+public:
+    /**
+     * A 2D position jump suppressor.
+     * Each position is compared to a prediction from the last accepted
+     * position and velocity. Positions that imply a speed or acceleration
+     * the object cannot achieve are marked invalid. Decisions are made on
+     * arrival, so no delay is added, and only the last accepted state is
+     * kept. If the object really has moved, e.g. after it was lost,
+     * consecutive rejections eventually cause the filter to re-anchor.
+     * @param position_source_address Un-filtered position SOURCE name
+     * @param position_sink_address Filtered position SINK name
+     */
+    using PositionFilter::PositionFilter;
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    // Last accepted position and smoothed velocity
+    bool anchored_ {false};
+    bool velocity_known_ {false};
+    oat::Point2D anchor_;
+    oat::Velocity2D velocity_;
+    double time_since_anchor_ {0.0};
+
+    // Gates. Speed or acceleration limits <= 0 disable that gate.
+    double max_speed_ {0.0};
+    double max_accel_ {0.0};
+    double tolerance_ {5.0};
+    int max_rejects_ {5};
+    int rejects_ {0};
+
+    /**
+     * Check a position against the speed and acceleration gates.
+     * @param p Position to check.
+     * @param dt Seconds since the anchor was accepted.
+     * @return True if the position is plausible.
+     */
+    bool plausible(const oat::Point2D &p, double dt) const;
+
+    /**
+     * Mark implausible positions invalid.
+     * @param position Position to filter
+     */
+    void filter(oat::Position2D& position) override;
+};
+
+}      /* namespace oat */
+#endif /* OAT_OUTLIERFILTER2D_H */
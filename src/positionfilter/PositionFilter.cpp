@@ -69,6 +69,9 @@ int PositionFilter::process()
     // Mess with internal frame
     filter(internal_position_);
 
+    if (!outputReady())
+        return 0;
+
     // START CRITICAL SECTION //
     ////////////////////////////
 
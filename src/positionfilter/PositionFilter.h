@@ -30,6 +30,8 @@
 #include "../../lib/shmemdf/Sink.h"
 #include "../../lib/shmemdf/Source.h"
 
+#include "TimeStep.h"
+
 namespace po = boost::program_options;
 
 namespace oat {
@@ -58,6 +60,30 @@ protected:
      */
     virtual void filter(oat::Position2D &position) = 0;
 
+    /**
+     * Check if filter() produced a position to publish. Filters that delay
+     * their output, e.g. a fixed-lag smoother, return false until the first
+     * delayed position is available.
+     * @return True if the filtered position should be published.
+     */
+    virtual bool outputReady(void) const { return true; }
+
+    /**
+     * Time step since the previous call, measured from sample timestamps.
+     * Falls back to dt_, or to the SOURCE's sample period if dt_ is not set,
+     * when the timestamps do not advance.
+     * @param sample Sample info of the position being filtered.
+     * @return Time step in seconds.
+     */
+    double timeStep(const oat::Sample &sample)
+    {
+        return oat::timeStep(sample, dt_, last_time_);
+    }
+
+    // Time step used when it cannot be measured from sample timestamps. 0
+    // indicates the SOURCE's sample period.
+    double dt_ {0.0};
+
 private:
     // Component Interface
     virtual bool connectToNode(void) override;
@@ -66,6 +92,9 @@ private:
     // Filter name
     const std::string name_;
 
+    // Timestamp of the previous call to timeStep()
+    oat::SampleTime last_time_;
+
     // Un-filtered position SOURCE
     const std::string position_source_address_;
     oat::Source<oat::Position2D> position_source_;
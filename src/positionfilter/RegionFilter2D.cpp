@@ -17,6 +17,8 @@
 //* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
 //******************************************************************************
 
+#include <algorithm>
+#include <limits>
 #include <ostream>
 #include <opencv2/core/types.hpp>
 #include <opencv2/imgproc.hpp>
@@ -31,12 +33,8 @@
 
 namespace oat {
 
-RegionFilter2D::~RegionFilter2D()
-{
-    for (auto &value : region_contours_) {
-        delete value;
-    }
-}
+// Largest region label map, in pixels (8 MB)
+static constexpr int REGION_MAP_MAX_PIXELS {1 << 22};
 
 po::options_description RegionFilter2D::options() const
 {
@@ -89,11 +87,14 @@ void RegionFilter2D::applyConfiguration(const po::variables_map &vm,
         oat::config::getArray(config_table, it->first, region_array);
 
         // Push the name of this region onto the id list
-        region_ids_.push_back(it->first);
-        if (region_ids_.back().size() > oat::Position2D::REGION_LEN)
-            std::cerr << oat::Warn("Region names are limited to 10 characters.");
+        if (it->first.size() >= oat::Position2D::REGION_LEN)
+            std::cerr << oat::Warn("Region names are limited to 9 characters.");
+
+        RegionID id {{0}};
+        it->first.copy(id.data(), id.size() - 1);
+        region_ids_.push_back(id);
 
-        region_contours_.push_back(new std::vector<cv::Point>());
+        region_contours_.emplace_back();
 
         auto region = region_array->nested_array();
         auto reg_it = region.begin();
@@ -109,12 +110,14 @@ void RegionFilter2D::applyConfiguration(const po::variables_map &vm,
             }
 
             auto p = cv::Point2d(point[0]->get(), point[1]->get());
-            region_contours_.back()->push_back(p);
+            region_contours_.back().push_back(p);
             reg_it++;
         }
         it++;
     }
 
+    buildLabelMap();
+
 //#ifndef NDEBUG
 //        //check the result
 //        for (size_t i = 0; i < region_contours_.size(); i++) {
@@ -127,26 +130,77 @@ void RegionFilter2D::applyConfiguration(const po::variables_map &vm,
 //#endif
 }
 
-void RegionFilter2D::filter(oat::Position2D &position) {
+void RegionFilter2D::buildLabelMap()
+{
+    if (region_contours_.empty())
+        return;
+
+    if (region_contours_.size() >= std::numeric_limits<uint16_t>::max())
+        return;
+
+    // Union of region bounds
+    std::vector<cv::Rect> bounds;
+    for (const auto &r : region_contours_) {
+        bounds.push_back(cv::boundingRect(r));
+        if (bounds.size() == 1)
+            label_box_ = bounds.back();
+        else
+            label_box_ |= bounds.back();
+    }
 
-    // Check the current position to see if it lies inside any regions.
-    if (position.position_valid) {
+    if (label_box_.area() > REGION_MAP_MAX_PIXELS) {
+        std::cerr << oat::Warn("Regions cover too large an area to rasterize. "
+                               "Each region will be tested in turn.\n");
+        label_box_ = cv::Rect();
+        return;
+    }
+
+    // Positions are looked up at integer coordinates, so testing each integer
+    // point within the bounds reproduces the per-sample polygon tests
+    // exactly. Earlier regions take precedence.
+    label_map_ = cv::Mat_<uint16_t>::zeros(label_box_.size());
+    for (size_t i = 0; i < region_contours_.size(); i++) {
+
+        const cv::Rect &b = bounds[i];
+        for (int y = b.y; y < b.y + b.height; y++) {
+            for (int x = b.x; x < b.x + b.width; x++) {
+
+                uint16_t &label = label_map_(y - label_box_.y, x - label_box_.x);
+                if (label == 0
+                    && cv::pointPolygonTest(
+                           region_contours_[i], cv::Point2f(x, y), false) >= 0)
+                    label = static_cast<uint16_t>(i + 1);
+            }
+        }
+    }
+}
 
-        cv::Point pt = (cv::Point)position.position;
-        std::vector<std::string>::size_type i = 0;
+int RegionFilter2D::regionLabel(const cv::Point &pt) const
+{
+    if (!label_map_.empty()) {
+        if (!label_box_.contains(pt))
+            return 0;
+        return label_map_(pt.y - label_box_.y, pt.x - label_box_.x);
+    }
 
-        for (auto &r : region_contours_) {
+    for (size_t i = 0; i < region_contours_.size(); i++) {
+        if (cv::pointPolygonTest(region_contours_[i], pt, false) >= 0)
+            return static_cast<int>(i + 1);
+    }
 
-            if (cv::pointPolygonTest(*r, pt, false) >= 0) {
+    return 0;
+}
 
-                position.region_valid = true;
-                std::vector<char> writable(region_ids_[i].begin(),
-                                           region_ids_[i].end());
-                writable.push_back('\0');
-                strcpy(position.region, &writable[0]);
-                break;
-            }
-            i++;
+void RegionFilter2D::filter(oat::Position2D &position) {
+
+    // Check the current position to see if it lies inside any regions.
+    if (position.position_valid) {
+
+        const int label = regionLabel((cv::Point)position.position);
+        if (label > 0) {
+            position.region_valid = true;
+            const auto &id = region_ids_[label - 1];
+            std::copy(id.begin(), id.end(), position.region);
         }
     }
 }
@@ -22,14 +22,14 @@
 
 #include "PositionFilter.h"
 
+#include <array>
 #include <string>
 #include <vector>
 #include <opencv2/core.hpp>
 
-namespace oat {
+#include "../../lib/datatypes/Position2D.h"
 
-// Forward decl.
-class Position2D;
+namespace oat {
 
 class RegionFilter2D : public PositionFilter {
 
@@ -43,17 +43,35 @@ public:
      */
     using PositionFilter::PositionFilter;
 
-    ~RegionFilter2D();
-
 private:
     // Configurable Interface
     po::options_description options() const override;
     void applyConfiguration(const po::variables_map &vm,
                             const config::OptionTable &config_table) override;
 
-    // Regions
-    std::vector<std::string> region_ids_;
-    std::vector<std::vector<cv::Point> *> region_contours_;
+    // Regions. IDs are stored ready to be copied into a position.
+    using RegionID = std::array<char, Position2D::REGION_LEN>;
+    std::vector<RegionID> region_ids_;
+    std::vector<std::vector<cv::Point>> region_contours_;
+
+    // Raster label map covering the bounding box of all regions. Each pixel
+    // holds 1 + the index of the first region containing it, or 0 if none
+    // do. Empty if the regions are too large to rasterize, in which case
+    // each region is tested in turn.
+    cv::Rect label_box_;
+    cv::Mat_<uint16_t> label_map_;
+
+    /**
+     * Rasterize the regions into label_map_.
+     */
+    void buildLabelMap(void);
+
+    /**
+     * Find the first region containing a point.
+     * @param pt Point to look up.
+     * @return 1 + index of the region, or 0 if pt is not in any region.
+     */
+    int regionLabel(const cv::Point &pt) const;
 
     /**
      * Check the position to see if it lies within any of the contours defined
@@ -0,0 +1,203 @@
+//******************************************************************************
+//* File:   SavitzkyGolay2D.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#include <cmath>
+#include <string>
+#include <cpptoml.h>
+#include <opencv2/core.hpp>
+
+#include "../../lib/utility/TOMLSanitize.h"
+
+#include "SavitzkyGolay2D.h"
+
+namespace oat {
+
+// Maximum window length
+static constexpr int SG_MAX_WINDOW {64};
+
+// Fractional deviation of sample spacing from its window mean below which
+// samples are treated as evenly spaced and precomputed coefficients are used
+static constexpr double SG_UNIFORM_TOLERANCE {0.05};
+
+po::options_description SavitzkyGolay2D::options() const
+{
+    // Update CLI options
+    po::options_description local_opts;
+    local_opts.add_options()
+        ("window,w", po::value<int>(),
+         "Number of samples, between 3 and 64, the polynomial is fit to. "
+         "Defaults to 9.")
+        ("order,o", po::value<int>(),
+         "Polynomial order, between 1 and 3. Must be less than the window "
+         "length. Defaults to 2.")
+        ("lag,L", po::value<int>(),
+         "Number of samples by which the output is delayed. The fit is "
+         "evaluated at this sample, so values near half the window reduce "
+         "noise at the cost of latency. 0 evaluates at the newest sample. "
+         "Defaults to 0.")
+        ("dt", po::value<double>(),
+         "Time step in seconds used when sample timestamps do not advance. "
+         "Defaults to the SOURCE's sample period.")
+        ;
+
+    return local_opts;
+}
+
+void SavitzkyGolay2D::applyConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Window
+    oat::config::getNumericValue<int>(
+        vm, config_table, "window", window_, 3, SG_MAX_WINDOW);
+
+    // Order
+    oat::config::getNumericValue<int>(vm, config_table, "order", order_, 1, 3);
+    if (order_ >= window_)
+        throw std::runtime_error("order must be less than window.");
+
+    // Lag
+    oat::config::getNumericValue<int>(
+        vm, config_table, "lag", lag_, 0, window_ - 1);
+
+    // Fallback time step
+    oat::config::getNumericValue<double>(vm, config_table, "dt", dt_, 0);
+
+    // Least-squares fit over evenly spaced samples, newest first, with time
+    // measured in samples from the evaluation point
+    cv::Mat A(window_, order_ + 1, CV_64F);
+    for (int m = 0; m < window_; m++) {
+        double u = 1.0;
+        for (int j = 0; j <= order_; j++, u *= lag_ - m)
+            A.at<double>(m, j) = u;
+    }
+    cv::invert(A, coeffs_, cv::DECOMP_SVD);
+
+    // All per-sample state is allocated here
+    ring_.resize(window_);
+    normal_.create(order_ + 1, order_ + 1, CV_64F);
+    rhs_.create(order_ + 1, 2, CV_64F);
+}
+
+void SavitzkyGolay2D::filter(oat::Position2D &position)
+{
+    // Only differences between tap times are used
+    t_ += timeStep(position.sample());
+
+    // Overwrite the oldest tap
+    const size_t n = ring_.size();
+    ring_[head_].position = position;
+    ring_[head_].t = t_;
+    head_ = (head_ + 1) % n;
+    if (filled_ < n)
+        filled_++;
+
+    if (!outputReady())
+        return;
+
+    // Publish the position lag samples back, with its own sample info
+    const auto tap = [this, n](size_t m) -> const Tap & {
+        return ring_[(head_ + n - 1 - m) % n];
+    };
+
+    position = tap(lag_).position;
+    position.velocity_valid = false;
+
+    // Only smooth, never extrapolate, a missing position
+    if (!position.position_valid || filled_ < 2)
+        return;
+
+    const double h = (tap(0).t - tap(filled_ - 1).t) / (filled_ - 1);
+    if (h <= 0)
+        return;
+
+    bool uniform = filled_ == n;
+    for (size_t m = 0; uniform && m < n; m++) {
+        uniform = tap(m).position.position_valid
+                  && (m == 0
+                      || std::abs(tap(m - 1).t - tap(m).t - h)
+                             <= SG_UNIFORM_TOLERANCE * h);
+    }
+
+    double c[2][2];
+    if (uniform) {
+
+        for (int j = 0; j < 2; j++) {
+            const double *w = coeffs_.ptr<double>(j);
+            c[0][j] = c[1][j] = 0.0;
+            for (size_t m = 0; m < n; m++) {
+                c[0][j] += w[m] * tap(m).position.position.x;
+                c[1][j] += w[m] * tap(m).position.position.y;
+            }
+        }
+
+    } else if (!fitWeighted(h, c)) {
+        return;
+    }
+
+    position.position.x = c[0][0];
+    position.position.y = c[1][0];
+    position.velocity.x = c[0][1] / h;
+    position.velocity.y = c[1][1] / h;
+    position.velocity_valid = true;
+}
+
+bool SavitzkyGolay2D::fitWeighted(double h, double c[2][2])
+{
+    const size_t n = ring_.size();
+    const double t_eval = ring_[(head_ + n - 1 - lag_) % n].t;
+
+    normal_.setTo(0.0);
+    rhs_.setTo(0.0);
+
+    // Normal equations over valid taps only
+    int count = 0;
+    double a[4];
+    for (size_t m = 0; m < filled_; m++) {
+
+        const Tap &tap = ring_[(head_ + n - 1 - m) % n];
+        if (!tap.position.position_valid)
+            continue;
+
+        const double u = (tap.t - t_eval) / h;
+        a[0] = 1.0;
+        for (int j = 1; j <= order_; j++)
+            a[j] = a[j - 1] * u;
+
+        for (int j = 0; j <= order_; j++) {
+            for (int k = 0; k <= order_; k++)
+                normal_.at<double>(j, k) += a[j] * a[k];
+            rhs_.at<double>(j, 0) += a[j] * tap.position.position.x;
+            rhs_.at<double>(j, 1) += a[j] * tap.position.position.y;
+        }
+
+        count++;
+    }
+
+    if (count <= order_
+        || !cv::solve(normal_, rhs_, solution_, cv::DECOMP_CHOLESKY))
+        return false;
+
+    for (int i = 0; i < 2; i++)
+        for (int j = 0; j < 2; j++)
+            c[i][j] = solution_.at<double>(j, i);
+
+    return true;
+}
+
+} /* namespace oat */
@@ -0,0 +1,102 @@
+//******************************************************************************
+//* File:   SavitzkyGolay2D.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_SAVITZKYGOLAY2D_H
+#define	OAT_SAVITZKYGOLAY2D_H
+
+#include "PositionFilter.h"
+
+#include <string>
+#include <vector>
+#include <opencv2/core/mat.hpp>
+
+namespace oat {
+
+class SavitzkyGolay2D : public PositionFilter {
+
+public:
+    /**
+     * A 2D Savitzky-Golay differentiating filter.
+     * A polynomial is least-squares fit to each axis of the last window
+     * positions and evaluated, along with its first derivative, lag samples
+     * before the newest one to produce smoothed position and velocity. When
+     * samples are evenly spaced, the fit reduces to a dot product with
+     * precomputed coefficients. Otherwise, e.g. after dropped frames or
+     * missing positions, the fit is weighted and solved using the sample
+     * timestamps.
+     * @param position_source_address Un-filtered position SOURCE name
+     * @param position_sink_address Smoothed position SINK name
+     */
+    using PositionFilter::PositionFilter;
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    // One sample in the window
+    struct Tap {
+        oat::Position2D position;   //!< Position as received
+        double t {0.0};             //!< Seconds since the first sample
+    };
+
+    // Ring of the last window_ taps. head_ indexes the oldest, which is the
+    // next to be overwritten.
+    int window_ {9};
+    int order_ {2};
+    int lag_ {0};
+    std::vector<Tap> ring_;
+    size_t head_ {0};
+    size_t filled_ {0};
+
+    // Precomputed coefficients, (order_ + 1) x window_. Row j, dotted with
+    // positions ordered newest first, gives the j-th polynomial coefficient
+    // in units of samples about the evaluation point.
+    cv::Mat coeffs_;
+
+    // Working buffers for fits over unevenly spaced samples
+    cv::Mat normal_, rhs_, solution_;
+
+    // Time of the newest tap
+    double t_ {0.0};
+
+    /**
+     * Least-squares fit the windowed positions by weighting each tap.
+     * @param h Time unit, in seconds, of the fit's abscissa.
+     * @param c Polynomial coefficients about the evaluation point, one row
+     * per axis.
+     * @return False if there are too few valid taps.
+     */
+    bool fitWeighted(double h, double c[2][2]);
+
+    /**
+     * Filter the incoming position and replace it with the smoothed position
+     * from lag samples earlier.
+     * @param position Position to filter
+     */
+    void filter(oat::Position2D& position) override;
+    bool outputReady(void) const override
+    {
+        return filled_ > static_cast<size_t>(lag_);
+    }
+};
+
+}      /* namespace oat */
+#endif /* OAT_SAVITZKYGOLAY2D_H */
@@ -0,0 +1,61 @@
+//******************************************************************************
+//* File:   TimeStep.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_TIMESTEP_H
+#define	OAT_TIMESTEP_H
+
+#include <cstdint>
+
+#include "../../lib/datatypes/Sample.h"
+
+namespace oat {
+
+/**
+ * Timestamp of the sample most recently passed to timeStep().
+ */
+struct SampleTime {
+    uint64_t usec {0};
+    bool valid {false};
+};
+
+/**
+ * @brief Time step since the previous sample, measured from sample
+ * timestamps. Falls back to dt, or to the sample period if dt is not set,
+ * when the timestamps do not advance.
+ * @param sample Sample info of the current sample.
+ * @param dt Fallback time step in seconds. 0 indicates the sample period.
+ * @param last Timestamp of the previous sample. Updated.
+ * @return Time step in seconds.
+ */
+inline double timeStep(const oat::Sample &sample,
+                       const double dt,
+                       oat::SampleTime &last)
+{
+    double step = dt > 0 ? dt : sample.period_sec().count();
+    const uint64_t usec = sample.microseconds().count();
+    if (last.valid && usec > last.usec)
+        step = (usec - last.usec) * 1.0e-6;
+    last.usec = usec;
+    last.valid = true;
+
+    return step;
+}
+
+}      /* namespace oat */
+#endif /* OAT_TIMESTEP_H */
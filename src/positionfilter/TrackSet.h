@@ -0,0 +1,435 @@
+//******************************************************************************
+//* File:   TrackSet.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#ifndef OAT_TRACKSET_H
+#define	OAT_TRACKSET_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "../../lib/datatypes/MultiPosition2D.h"
+
+#include "KinematicKalman.h"
+
+namespace oat {
+
+/**
+ * A set of object tracks maintained from successive sets of detections.
+ * Each track is a constant velocity Kalman filter. On each update, tracks
+ * are predicted forward and detections are assigned to them by minimizing
+ * total Mahalanobis distance (or greedily by nearest neighbour) subject to a
+ * gate. Unassigned detections start tentative tracks, which are confirmed
+ * after a number of hits. Tracks are deleted after a number of consecutive
+ * misses. All storage is fixed size, so tracking performs no heap
+ * allocation.
+ */
+class TrackSet {
+
+public:
+    static constexpr size_t MAX_TRACKS {MultiPosition2D::MAX_POSITIONS};
+
+    // Row major, track by detection, cost matrix and the detection assigned
+    // to each track, or -1
+    using CostMatrix = std::array<double, MAX_TRACKS * MAX_TRACKS>;
+    using Assignment = std::array<int, MAX_TRACKS>;
+
+    /**
+     * @brief Set the data association method.
+     * @param optimal If true, minimize total cost using the Hungarian
+     * algorithm. Otherwise, greedily assign the cheapest pairs first.
+     */
+    void set_optimal(const bool optimal) { optimal_ = optimal; }
+
+    /**
+     * @brief Set the gate and track management parameters.
+     * @param gate Largest distance, in standard deviations of a track's
+     * predicted position, at which a detection can be assigned to it.
+     * @param confirm_hits Hits before a tentative track is confirmed.
+     * @param max_misses Consecutive misses before a confirmed track is
+     * deleted.
+     */
+    void set_gating(const double gate,
+                    const int confirm_hits,
+                    const int max_misses)
+    {
+        gate_ = gate;
+        confirm_hits_ = confirm_hits;
+        max_misses_ = max_misses;
+    }
+
+    double gate(void) const { return gate_; }
+    int confirm_hits(void) const { return confirm_hits_; }
+    int max_misses(void) const { return max_misses_; }
+
+    /**
+     * @brief Set the motion and measurement model.
+     * @param sigma_accel Standard deviation of random accelerations.
+     * @param sigma_noise Standard deviation of position measurement noise.
+     */
+    void set_model(const double sigma_accel, const double sigma_noise)
+    {
+        sig_accel_ = sigma_accel;
+        sig_measure_noise_ = sigma_noise;
+    }
+
+    double sigma_accel(void) const { return sig_accel_; }
+    double sigma_noise(void) const { return sig_measure_noise_; }
+
+    /**
+     * @brief Update tracks with a set of detections.
+     * @param detections Detected positions.
+     * @param dt Time since the previous update in seconds.
+     * @param tracked Confirmed tracks, with their IDs.
+     */
+    void update(const oat::MultiPosition2D &detections,
+                const double dt,
+                oat::MultiPosition2D &tracked);
+
+    /**
+     * @brief Number of tracks, tentative and confirmed.
+     */
+    size_t size(void) const { return num_tracks_; }
+
+    /**
+     * @brief Minimum cost assignment of tracks to detections using the
+     * Hungarian algorithm. O(n^3) in n = max(n_tracks, n_det).
+     * @param cost Cost matrix. Must be padded to n x n with the cost of
+     * leaving a track or detection unassigned.
+     * @param n_tracks Number of tracks.
+     * @param n_det Number of detections.
+     * @param track_det Assignment output.
+     */
+    static void assignOptimal(const CostMatrix &cost,
+                              const size_t n_tracks,
+                              const size_t n_det,
+                              Assignment &track_det);
+
+    /**
+     * @brief Greedy nearest neighbour assignment of tracks to detections.
+     * @param cost Cost matrix.
+     * @param n_tracks Number of tracks.
+     * @param n_det Number of detections.
+     * @param max_cost Pairs costing this much or more are not assigned.
+     * @param track_det Assignment output.
+     */
+    static void assignGreedy(const CostMatrix &cost,
+                             const size_t n_tracks,
+                             const size_t n_det,
+                             const double max_cost,
+                             Assignment &track_det);
+
+private:
+    /**
+     * @brief Fill cost_ with the gated, squared Mahalanobis distance
+     * between each track's predicted position and each detection.
+     * @param detections Detected positions.
+     * @param valid Indices of valid detections.
+     * @param n_det Number of valid detections.
+     */
+    void computeCosts(const oat::MultiPosition2D &detections,
+                      const std::array<size_t, MAX_TRACKS> &valid,
+                      const size_t n_det);
+
+    /// A tracked object
+    struct Track {
+        oat::KinematicKalman<2> axes[2];
+        uint32_t id {0};
+        int hits {0};
+        int misses {0};
+        bool confirmed {false};
+    };
+
+    // Tracks, stored contiguously in [0, num_tracks_)
+    std::array<Track, MAX_TRACKS> tracks_;
+    size_t num_tracks_ {0};
+    uint32_t next_id_ {0};
+
+    // Assignment buffers
+    CostMatrix cost_;
+    Assignment track_det_;
+    bool optimal_ {true};
+
+    // Model parameters
+    double sig_accel_ {5.0};
+    double sig_measure_noise_ {1.0};
+
+    // Gate in standard deviations of the predicted position and track
+    // management parameters
+    double gate_ {3.0};
+    int confirm_hits_ {3};
+    int max_misses_ {5};
+};
+
+inline void TrackSet::update(const oat::MultiPosition2D &detections,
+                             const double dt,
+                             oat::MultiPosition2D &tracked)
+{
+    for (size_t t = 0; t < num_tracks_; t++)
+        for (auto &a : tracks_[t].axes)
+            a.predict(dt, sig_accel_);
+
+    // Valid detections
+    std::array<size_t, MAX_TRACKS> valid;
+    size_t n_det = 0;
+    for (size_t d = 0; d < detections.size(); d++)
+        if (detections[d].position_valid)
+            valid[n_det++] = d;
+
+    // Data association
+    const double gate_sq = gate_ * gate_;
+    computeCosts(detections, valid, n_det);
+    if (optimal_)
+        assignOptimal(cost_, num_tracks_, n_det, track_det_);
+    else
+        assignGreedy(cost_, num_tracks_, n_det, gate_sq, track_det_);
+
+    // Update assigned tracks and count misses
+    const double r = sig_measure_noise_ * sig_measure_noise_;
+    std::array<bool, MAX_TRACKS> det_used;
+    det_used.fill(false);
+
+    for (size_t t = 0; t < num_tracks_; t++) {
+
+        auto &trk = tracks_[t];
+        const int d = track_det_[t];
+
+        if (d >= 0 && cost_[t * MAX_TRACKS + d] < gate_sq) {
+
+            const auto &z = detections[valid[d]].position;
+            trk.axes[0].correct(z.x, r);
+            trk.axes[1].correct(z.y, r);
+            det_used[d] = true;
+
+            trk.misses = 0;
+            if (++trk.hits >= confirm_hits_)
+                trk.confirmed = true;
+
+        } else {
+            trk.misses++;
+        }
+    }
+
+    // Delete tentative tracks that missed and confirmed tracks that have
+    // missed too many times. Order does not matter, so fill gaps from the end.
+    for (size_t t = 0; t < num_tracks_;) {
+        const auto &trk = tracks_[t];
+        if ((!trk.confirmed && trk.misses > 0) || trk.misses > max_misses_)
+            tracks_[t] = tracks_[--num_tracks_];
+        else
+            t++;
+    }
+
+    // Start tentative tracks at unassigned detections
+    for (size_t d = 0; d < n_det && num_tracks_ < MAX_TRACKS; d++) {
+
+        if (det_used[d])
+            continue;
+
+        auto &trk = tracks_[num_tracks_++];
+        const auto &z = detections[valid[d]].position;
+        trk.axes[0].reset(z.x, 1000.0);
+        trk.axes[1].reset(z.y, 1000.0);
+        trk.id = next_id_++;
+        trk.hits = 1;
+        trk.misses = 0;
+        trk.confirmed = confirm_hits_ <= 1;
+    }
+
+    // Publish confirmed tracks
+    tracked.clear();
+    tracked.set_sample(detections.sample());
+
+    oat::Position2D pos;
+    pos.position_valid = true;
+    pos.velocity_valid = true;
+    for (size_t t = 0; t < num_tracks_; t++) {
+
+        const auto &trk = tracks_[t];
+        if (!trk.confirmed)
+            continue;
+
+        pos.position.x = trk.axes[0].state()(0);
+        pos.velocity.x = trk.axes[0].state()(1);
+        pos.position.y = trk.axes[1].state()(0);
+        pos.velocity.y = trk.axes[1].state()(1);
+        tracked.push_back(pos, trk.id);
+    }
+}
+
+inline void TrackSet::computeCosts(const oat::MultiPosition2D &detections,
+                                   const std::array<size_t, MAX_TRACKS> &valid,
+                                   const size_t n_det)
+{
+    // Pairs outside the gate cost the same as leaving a track or detection
+    // unassigned, which is also the cost of the padding that squares the
+    // matrix. So a pair is only assigned if it is within the gate and
+    // lowers the total cost.
+    const double gate_sq = gate_ * gate_;
+    const double r = sig_measure_noise_ * sig_measure_noise_;
+    const size_t n = std::max(num_tracks_, n_det);
+
+    for (size_t t = 0; t < n; t++) {
+
+        double *row = cost_.data() + t * MAX_TRACKS;
+        if (t >= num_tracks_) {
+            std::fill(row, row + n, gate_sq);
+            continue;
+        }
+
+        const auto &trk = tracks_[t];
+        const double px = trk.axes[0].state()(0);
+        const double py = trk.axes[1].state()(0);
+        const double sx = 1.0 / (trk.axes[0].covariance()(0, 0) + r);
+        const double sy = 1.0 / (trk.axes[1].covariance()(0, 0) + r);
+
+        for (size_t d = 0; d < n; d++) {
+
+            if (d >= n_det) {
+                row[d] = gate_sq;
+                continue;
+            }
+
+            const auto &z = detections[valid[d]].position;
+            const double ex = z.x - px;
+            const double ey = z.y - py;
+            row[d] = std::min(gate_sq, ex * ex * sx + ey * ey * sy);
+        }
+    }
+}
+
+inline void TrackSet::assignOptimal(const CostMatrix &cost,
+                                    const size_t n_tracks,
+                                    const size_t n_det,
+                                    Assignment &track_det)
+{
+    // Hungarian algorithm with potentials (shortest augmenting paths) on the
+    // square, padded cost matrix. Indices are 1-based; column 0 is a virtual
+    // start.
+    const size_t n = std::max(n_tracks, n_det);
+    const double inf = std::numeric_limits<double>::infinity();
+
+    std::array<double, MAX_TRACKS + 1> u, v, min_v;
+    std::array<size_t, MAX_TRACKS + 1> match, way;
+    std::array<bool, MAX_TRACKS + 1> used;
+    u.fill(0);
+    v.fill(0);
+    match.fill(0);
+    way.fill(0);
+
+    for (size_t i = 1; i <= n; i++) {
+
+        match[0] = i;
+        size_t j0 = 0;
+        min_v.fill(inf);
+        used.fill(false);
+
+        do {
+            used[j0] = true;
+            const size_t i0 = match[j0];
+            double delta = inf;
+            size_t j1 = 0;
+
+            for (size_t j = 1; j <= n; j++) {
+                if (used[j])
+                    continue;
+
+                const double c
+                    = cost[(i0 - 1) * MAX_TRACKS + (j - 1)] - u[i0] - v[j];
+                if (c < min_v[j]) {
+                    min_v[j] = c;
+                    way[j] = j0;
+                }
+                if (min_v[j] < delta) {
+                    delta = min_v[j];
+                    j1 = j;
+                }
+            }
+
+            for (size_t j = 0; j <= n; j++) {
+                if (used[j]) {
+                    u[match[j]] += delta;
+                    v[j] -= delta;
+                } else {
+                    min_v[j] -= delta;
+                }
+            }
+
+            j0 = j1;
+
+        } while (match[j0] != 0);
+
+        // Augment along the path
+        do {
+            const size_t j1 = way[j0];
+            match[j0] = match[j1];
+            j0 = j1;
+        } while (j0 != 0);
+    }
+
+    track_det.fill(-1);
+    for (size_t j = 1; j <= n; j++) {
+        const size_t t = match[j] - 1;
+        if (t < n_tracks && j - 1 < n_det)
+            track_det[t] = static_cast<int>(j - 1);
+    }
+}
+
+inline void TrackSet::assignGreedy(const CostMatrix &cost,
+                                   const size_t n_tracks,
+                                   const size_t n_det,
+                                   const double max_cost,
+                                   Assignment &track_det)
+{
+    // Repeatedly take the cheapest remaining pair
+    std::array<bool, MAX_TRACKS> det_taken;
+    det_taken.fill(false);
+    track_det.fill(-1);
+
+    for (;;) {
+
+        double best = max_cost;
+        size_t best_t = 0, best_d = 0;
+        bool found = false;
+
+        for (size_t t = 0; t < n_tracks; t++) {
+            if (track_det[t] >= 0)
+                continue;
+            const double *row = cost.data() + t * MAX_TRACKS;
+            for (size_t d = 0; d < n_det; d++) {
+                if (!det_taken[d] && row[d] < best) {
+                    best = row[d];
+                    best_t = t;
+                    best_d = d;
+                    found = true;
+                }
+            }
+        }
+
+        if (!found)
+            break;
+
+        track_det[best_t] = static_cast<int>(best_d);
+        det_taken[best_d] = true;
+    }
+}
+
+}      /* namespace oat */
+#endif /* OAT_TRACKSET_H */
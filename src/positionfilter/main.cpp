@@ -33,6 +33,10 @@
 #include "HomographyTransform2D.h"
 #include "KalmanFilter2D.h"
 #include "RegionFilter2D.h"
+#include "FixedLagSmoother2D.h"
+#include "MultiTracker2D.h"
+#include "SavitzkyGolay2D.h"
+#include "OutlierFilter2D.h"
 
 #define REQ_POSITIONAL_ARGS 3
 
@@ -42,7 +46,11 @@ const char usage_type[] =
     "TYPE\n"
     "  kalman: Kalman filter\n"
     "  homography: homography transform\n"
-    "  region: position region annotation";
+    "  region: position region annotation\n"
+    "  smooth: fixed-lag Kalman smoother\n"
+    "  track: multi-object tracker of multi-position streams\n"
+    "  savgol: Savitzky-Golay position and velocity estimator\n"
+    "  reject: outlier and jump rejection";
 
 const char usage_io[] =
     "SOURCE:\n"
@@ -92,10 +100,15 @@ int main(int argc, char *argv[])
     type_hash["kalman"] = 'a';
     type_hash["homography"] = 'b';
     type_hash["region"] = 'c';
+    type_hash["smooth"] = 'd';
+    type_hash["track"] = 'e';
+    type_hash["savgol"] = 'f';
+    type_hash["reject"] = 'g';
 
     // The component itself
     std::string comp_name = "posifilt";
-    std::shared_ptr<oat::PositionFilter> filter;
+    std::shared_ptr<oat::Component> filter;
+    std::shared_ptr<oat::Configurable<false>> config;
 
     // Program options
     po::options_description visible_options;
@@ -164,6 +177,26 @@ int main(int argc, char *argv[])
                     filter = std::make_shared<oat::RegionFilter2D>(source, sink);
                     break;
                 }
+                case 'd':
+                {
+                    filter = std::make_shared<oat::FixedLagSmoother2D>(source, sink);
+                    break;
+                }
+                case 'e':
+                {
+                    filter = std::make_shared<oat::MultiTracker2D>(source, sink);
+                    break;
+                }
+                case 'f':
+                {
+                    filter = std::make_shared<oat::SavitzkyGolay2D>(source, sink);
+                    break;
+                }
+                case 'g':
+                {
+                    filter = std::make_shared<oat::OutlierFilter2D>(source, sink);
+                    break;
+                }
                 default:
                 {
                     printUsage(visible_options, "");
@@ -172,9 +205,13 @@ int main(int argc, char *argv[])
                 }
             }
 
+            // Not all TYPEs are PositionFilters (e.g. track), so configure
+            // through the Configurable interface
+            config = std::dynamic_pointer_cast<oat::Configurable<false>>(filter);
+
             // Specialize program options for the selected TYPE
             po::options_description detail_opts {"CONFIGURATION"};
-            filter->appendOptions(detail_opts);
+            config->appendOptions(detail_opts);
             visible_options.add(detail_opts);
             options.add(detail_opts);
         }
@@ -228,7 +265,7 @@ int main(int argc, char *argv[])
                  .run(), option_map);
         po::notify(option_map);
 
-        filter->configure(option_map);
+        config->configure(option_map);
 
         // Tell user
         std::cout << oat::whoMessage(comp_name,
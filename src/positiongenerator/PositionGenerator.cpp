@@ -20,10 +20,12 @@
 #include <chrono>
 #include <string>
 #include <thread>
+#include <vector>
 #include <cpptoml.h>
 
 #include "../../lib/utility/TOMLSanitize.h"
 #include "../../lib/utility/IOFormat.h"
+#include "../../lib/utility/make_unique.h"
 
 #include "PositionGenerator.h"
 
@@ -36,6 +38,20 @@ PositionGenerator::PositionGenerator(const std::string &position_sink_address)
     tick_ = clock_.now();
 }
 
+PositionGenerator::~PositionGenerator()
+{
+    // Publishers finish the batch they were given before joining
+    {
+        std::lock_guard<std::mutex> lk(publish_mutex_);
+        running_ = false;
+    }
+    batch_ready_.notify_all();
+
+    for (auto &p : publishers_)
+        if (p.joinable())
+            p.join();
+}
+
 po::options_description PositionGenerator::baseOptions(void) const
 {
     po::options_description base_opts;
@@ -47,63 +63,200 @@ po::options_description PositionGenerator::baseOptions(void) const
         ("num-samples,n", po::value<uint64_t>(),
         "Number of position samples to generate and serve. Deafaults to "
         "approximately infinite.")
+        ("batch", po::value<size_t>(),
+        "Number of samples generated at a time. Larger batches reduce "
+        "per-sample overhead at high rates, including the hand-off to the "
+        "per-agent publishing threads used when there is more than one "
+        "agent; when a rate is specified, the sample clock is enforced once "
+        "per batch. Defaults to 1.")
+        ;
+
+    return base_opts;
+}
+
+po::options_description PositionGenerator::roomOptions(void) const
+{
+    po::options_description room_opts;
+
+    room_opts.add_options()
         ("room,R", po::value<std::string>(),
          "Array of floats, [x0,y0,width,height], specifying the boundaries in "
          "which generated positions reside. The room has periodic boundaries so "
          "when a position leaves one side it will enter the opposing one.")
         ;
 
-    return base_opts;
+    return room_opts;
+}
+
+void PositionGenerator::applyBaseConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    // Rate
+    double fs = 1e8; // Very fast s.t. process cannot keep up
+    if (oat::config::getNumericValue<double>(vm, config_table, "rate", fs, 0))
+        enforce_sample_clock_ = true;
+    generateSamplePeriod(fs);
+
+    // Number of samples
+    oat::config::getNumericValue<uint64_t>(
+        vm, config_table, "num-samples", num_samples_, 0);
+
+    // Batch size
+    oat::config::getNumericValue<size_t>(
+        vm, config_table, "batch", batch_steps_, 1);
+}
+
+void PositionGenerator::applyRoomConfiguration(
+    const po::variables_map &vm, const config::OptionTable &config_table)
+{
+    std::vector<double> r;
+    if (oat::config::getArray<double, 4>(vm, config_table, "room", r)) {
+        room_.x = r[0];
+        room_.y = r[1];
+        room_.width = r[2];
+        room_.height = r[3];
+    }
 }
 
 bool PositionGenerator::connectToNode()
 {
-    // Bind to sink sink node and create a shared position
-    position_sink_.bind(position_sink_address_, position_sink_address_);
-    shared_position_ = position_sink_.retrieve();
+    // Bind to sink sink node and create a shared position for each agent
+    for (size_t k = 0; k < num_agents_; k++) {
+
+        const auto addr = num_agents_ == 1
+                        ? position_sink_address_
+                        : position_sink_address_ + "_" + std::to_string(k);
+
+        position_sinks_.push_back(
+            oat::make_unique<oat::Sink<oat::Position2D>>());
+        position_sinks_.back()->bind(addr, addr);
+        shared_positions_.push_back(position_sinks_.back()->retrieve());
+    }
+
+    // Setup sample rate info
+    oat::Sample sample;
+    sample.set_rate_hz(1.0 / sample_period_in_sec_.count());
+    samples_.assign(num_agents_, sample);
 
-    // Setup sample rate info on internal copy
-    internal_position_.set_rate_hz(1.0 / sample_period_in_sec_.count());
+    batch_.resize(batch_steps_ * num_agents_);
+    published_.resize(batch_steps_ * num_agents_);
+
+    if (num_agents_ > 1)
+        for (size_t k = 0; k < num_agents_; k++)
+            publishers_.emplace_back(&PositionGenerator::publishLoop, this, k);
 
     return true;
 }
 
 int PositionGenerator::process()
 {
-    // Generate internal position
-    bool eof = generatePosition(internal_position_);
+    // Generate internal positions
+    const size_t steps = generateBatch(batch_);
 
-    // START CRITICAL SECTION //
-    ////////////////////////////
+    if (num_agents_ == 1) {
+        publish(batch_, 0, steps);
+        keepSampleClock(steps);
+        return steps < batch_steps_;
+    }
 
-    // Wait for sources to read
-    position_sink_.wait();
+    // Wait for the previous batch to be published
+    std::unique_lock<std::mutex> lk(publish_mutex_);
+    batch_done_.wait(lk, [this] { return publishing_ == 0; });
 
-    if (first_pos_) {
-        first_pos_ = false;
-        start_ = clock_.now();
+    if (batch_count_ > 0) {
+        lk.unlock();
+        keepSampleClock(published_steps_);
+        lk.lock();
     }
 
-    *shared_position_ = internal_position_;
+    // Hand the new batch to the publishers
+    std::swap(batch_, published_);
+    published_steps_ = steps;
+    publishing_ = num_agents_;
+    batch_count_++;
+    lk.unlock();
+    batch_ready_.notify_all();
 
-    // Tell sources there is new data
-    position_sink_.post();
-
-    ////////////////////////////
-    //  END CRITICAL SECTION  //
+    return steps < batch_steps_;
+}
 
+void PositionGenerator::keepSampleClock(const size_t steps)
+{
+    // Keep to the sample clock on average over each batch
     if (enforce_sample_clock_) {
-        auto tock = clock_.now();
-        std::this_thread::sleep_for(sample_period_in_sec_ - (tock - tick_));
-        tick_ = clock_.now();
+        tick_ += std::chrono::duration_cast<
+            std::chrono::high_resolution_clock::duration>(
+            sample_period_in_sec_ * static_cast<double>(steps));
+        std::this_thread::sleep_until(tick_);
     }
+}
 
-    // Pure SINKs increment sample count
-    auto time_since_start = std::chrono::duration_cast<Sample::Microseconds>(
-        clock_.now() - start_);
-    internal_position_.incrementSampleCount(time_since_start);
+void PositionGenerator::publishLoop(const size_t agent)
+{
+    uint64_t count = 0;
 
-    return eof;
+    while (true) {
+
+        size_t steps;
+        {
+            std::unique_lock<std::mutex> lk(publish_mutex_);
+            batch_ready_.wait(lk, [&] {
+                return batch_count_ != count || !running_;
+            });
+
+            // Stopped with no batch pending
+            if (batch_count_ == count)
+                return;
+
+            count = batch_count_;
+            steps = published_steps_;
+        }
+
+        publish(published_, agent, steps);
+
+        {
+            std::lock_guard<std::mutex> lk(publish_mutex_);
+            if (--publishing_ == 0)
+                batch_done_.notify_one();
+        }
+    }
+}
+
+void PositionGenerator::publish(const std::vector<oat::Position2D> &batch,
+                                const size_t agent,
+                                const size_t steps)
+{
+    oat::Sink<oat::Position2D> &sink = *position_sinks_[agent];
+    oat::Position2D &shared_position = *shared_positions_[agent];
+    oat::Sample &sample = samples_[agent];
+
+    for (size_t s = 0; s < steps; s++) {
+
+        // START CRITICAL SECTION //
+        ////////////////////////////
+
+        // Wait for sources to read
+        sink.wait();
+
+        std::call_once(start_once_, [this] {
+            start_ = clock_.now();
+            tick_ = start_;
+        });
+
+        shared_position = batch[s * num_agents_ + agent];
+        shared_position.set_sample(sample);
+
+        // Tell sources there is new data
+        sink.post();
+
+        ////////////////////////////
+        //  END CRITICAL SECTION  //
+
+        // Pure SINKs increment sample count
+        auto time_since_start = std::chrono::duration_cast<Sample::Microseconds>(
+            clock_.now() - start_);
+        sample.incrementCount(time_since_start);
+    }
 }
 
 void PositionGenerator::generateSamplePeriod(const double samples_per_second)
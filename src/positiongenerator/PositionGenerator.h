@@ -21,9 +21,14 @@
 #define	OAT_POSITIONGENERATOR_H
 
 #include <chrono>
+#include <condition_variable>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <random>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <boost/program_options.hpp>
 #include <opencv2/core/mat.hpp>
@@ -48,7 +53,7 @@ public:
      * @param position_sink_name Position SINK to publish test positions
      */
     PositionGenerator(const std::string &position_sink_address);
-    virtual ~PositionGenerator() { };
+    virtual ~PositionGenerator();
 
     // Component Interface
     oat::ComponentType type(void) const override { return oat::positiongenerator; };
@@ -56,11 +61,14 @@ public:
 
 protected:
     /**
-     * Generate test position.
-     * @param position Generated position.
-     * @return true if EOF has been genereated, false otherwise.
+     * Generate a batch of test positions.
+     * @param batch Generated positions for batch_steps_ consecutive samples
+     * of each of num_agents_ agents, stored sample-major: the position of
+     * agent k at step s is batch[s * num_agents_ + k].
+     * @return Number of steps generated. Fewer than batch_steps_ indicates
+     * EOF.
      */
-    virtual bool generatePosition(oat::Position2D &position) = 0;
+    virtual size_t generateBatch(std::vector<oat::Position2D> &batch) = 0;
 
     // Test position sample clock
     bool enforce_sample_clock_ {false};
@@ -75,6 +83,11 @@ protected:
     uint64_t num_samples_ {std::numeric_limits<uint64_t>::max()};
     uint64_t it_ {0};
 
+    // Number of simulated agents, each published to its own SINK, and number
+    // of samples generated at a time
+    size_t num_agents_ {1};
+    size_t batch_steps_ {1};
+
     /**
      * Configure the sample period
      * @param samples_per_second Sample period in seconds.
@@ -88,6 +101,29 @@ protected:
      */
     po::options_description baseOptions(void) const;
 
+    /**
+     * @brief Provide a copy of the simulated room program options for
+     * derived types that need it.
+     * @return Room program options description.
+     */
+    po::options_description roomOptions(void) const;
+
+    /**
+     * @brief Apply base program options.
+     * @param vm Pre-parse program option map.
+     * @param config_table Parsed TOML options table.
+     */
+    void applyBaseConfiguration(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
+
+    /**
+     * @brief Apply simulated room program options.
+     * @param vm Pre-parse program option map.
+     * @param config_table Parsed TOML options table.
+     */
+    void applyRoomConfiguration(const po::variables_map &vm,
+                                const config::OptionTable &config_table);
+
 private:
     // Component Interface
     virtual bool connectToNode(void) override;
@@ -96,18 +132,37 @@ private:
     // Test position name
     std::string name_;
 
-    // Internally generated position
-    oat::Position2D internal_position_ {"internal"};
-
-    // Shared position
-    oat::Position2D * shared_position_;
-
-    // First position
-    bool first_pos_ {true};
-
-    // The test position SINK
+    // Internally generated positions, and the batch being published
+    std::vector<oat::Position2D> batch_, published_;
+    size_t published_steps_ {0};
+
+    // Shared positions and their samples, one per agent
+    std::vector<oat::Position2D *> shared_positions_;
+    std::vector<oat::Sample> samples_;
+
+    // Sample clock starts when the first position is read
+    std::once_flag start_once_;
+    void keepSampleClock(const size_t steps);
+
+    // With more than one agent, each agent's SINK is published from its own
+    // persistent thread so that a slow consumer of one agent does not hold
+    // back the consumers of the others. The next batch is generated while
+    // the current one is published.
+    std::vector<std::thread> publishers_;
+    std::mutex publish_mutex_;
+    std::condition_variable batch_ready_, batch_done_;
+    uint64_t batch_count_ {0};
+    size_t publishing_ {0};
+    bool running_ {true};
+    void publishLoop(const size_t agent);
+    void publish(const std::vector<oat::Position2D> &batch,
+                 const size_t agent,
+                 const size_t steps);
+
+    // The test position SINKs. SINK for a single agent, SINK_k for agent k
+    // otherwise.
     std::string position_sink_address_;
-    oat::Sink<oat::Position2D> position_sink_;
+    std::vector<std::unique_ptr<oat::Sink<oat::Position2D>>> position_sinks_;
 };
 
 }      /* namespace oat */
@@ -0,0 +1,152 @@
+//******************************************************************************
+//* File:   PositionReplay.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//*****************************************************************************
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "../../lib/utility/TOMLSanitize.h"
+#include "../../lib/datatypes/Position2D.h"
+
+#include "PositionReplay.h"
+
+namespace oat {
+
+po::options_description PositionReplay::options() const
+{
+    // Update CLI options
+    // Start with base options
+    po::options_description local_opts(baseOptions());
+
+    // Add local options
+    local_opts.add_options()
+        ("file,f", po::value<std::string>(),
+         "Array of strings, [\"path0\",\"path1\",...], specifying .npy position "
+         "files written by oat-record. Each file is replayed as a separate "
+         "agent. If more than one file is given, agent k is published to "
+         "SINK_k.")
+        ("loop", "If set, restart each file from its first record after "
+         "its last instead of ending the stream. Otherwise, the stream ends "
+         "with the shortest file.")
+        ;
+
+    return local_opts;
+}
+
+void PositionReplay::applyConfiguration(const po::variables_map &vm,
+                                        const config::OptionTable &config_table)
+{
+    // Rate, number of samples, and batch size
+    applyBaseConfiguration(vm, config_table);
+
+    // Files
+    std::vector<std::string> files;
+    oat::config::getArray<std::string>(vm, config_table, "file", files, true);
+    if (files.empty())
+        throw std::runtime_error("At least one file must be specified.");
+
+    num_agents_ = files.size();
+    records_.resize(num_agents_);
+    num_records_ = std::numeric_limits<uint64_t>::max();
+    for (size_t k = 0; k < num_agents_; k++)
+        num_records_ = std::min<uint64_t>(num_records_,
+                                          loadRecords(files[k], records_[k]));
+
+    if (num_records_ == 0)
+        throw std::runtime_error("Position files contain no records.");
+
+    oat::config::getValue<bool>(vm, config_table, "loop", loop_);
+}
+
+size_t PositionReplay::loadRecords(const std::string &path,
+                                   std::vector<char> &records)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        throw std::runtime_error("Could not open " + path + ".");
+
+    const auto file_bytes = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    // Magic string and version
+    char prefix[8];
+    if (!file.read(prefix, sizeof(prefix))
+        || std::string(prefix, 6) != std::string("\x93NUMPY"))
+        throw std::runtime_error(path + " is not an .npy file.");
+
+    // Header length is 2 bytes for version 1 and 4 bytes for later versions
+    size_t header_len = 0;
+    const int len_bytes = prefix[6] == 1 ? 2 : 4;
+    for (int i = 0; i < len_bytes; i++)
+        header_len |= static_cast<size_t>(static_cast<uint8_t>(file.get())) << (8 * i);
+
+    std::string header(header_len, '\0');
+    if (!file.read(&header[0], header_len))
+        throw std::runtime_error(path + " has a truncated header.");
+
+    // Records must be laid out exactly as oat-record writes them
+    const auto strip = [](std::string s) {
+        s.erase(std::remove_if(s.begin(), s.end(), ::isspace), s.end());
+        return s;
+    };
+
+    const auto h = strip(header);
+    const auto dtype = strip(oat::Position2D::NPY_DTYPE);
+    if (h.find("'descr':" + dtype) == std::string::npos
+        || h.find("'fortran_order':False") == std::string::npos)
+        throw std::runtime_error(path + " does not contain positions "
+                                 "recorded by oat-record.");
+
+    // The record count is taken from the file size rather than the header so
+    // that recordings that were not closed cleanly can be replayed
+    const size_t data_start = static_cast<size_t>(file.tellg());
+    const size_t n = (file_bytes - data_start) / oat::Position2D::NPY_DTYPE_BYTES;
+
+    records.resize(n * oat::Position2D::NPY_DTYPE_BYTES);
+    if (!file.read(records.data(), records.size()))
+        throw std::runtime_error("Could not read records from " + path + ".");
+
+    return n;
+}
+
+size_t PositionReplay::generateBatch(std::vector<oat::Position2D> &batch)
+{
+    const size_t n = num_agents_;
+
+    size_t s = 0;
+    for (; s < batch_steps_ && it_ < num_samples_; s++, it_++) {
+
+        if (!loop_ && it_ >= num_records_)
+            break;
+
+        const size_t offset
+            = (it_ % num_records_) * oat::Position2D::NPY_DTYPE_BYTES;
+
+        for (size_t k = 0; k < n; k++)
+            oat::unpackPosition(records_[k].data() + offset, batch[s * n + k]);
+    }
+
+    return s;
+}
+
+} /* namespace oat */
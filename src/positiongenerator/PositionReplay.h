@@ -0,0 +1,69 @@
+//******************************************************************************
+//* File:   PositionReplay.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//*****************************************************************************
+
+#ifndef OAT_POSITIONREPLAY_H
+#define	OAT_POSITIONREPLAY_H
+
+#include <string>
+#include <vector>
+
+#include "../../lib/datatypes/Position2D.h"
+
+#include "PositionGenerator.h"
+
+namespace oat {
+
+class PositionReplay : public PositionGenerator {
+
+public:
+
+    /**
+     * A recorded position player.
+     * Serves positions from .npy files written by oat-record, one file per
+     * agent. Files are loaded into memory up front so that positions can be
+     * served at rates well beyond the disk's.
+     */
+    using PositionGenerator::PositionGenerator;
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    size_t generateBatch(std::vector<oat::Position2D> &batch) override;
+
+    /**
+     * @brief Load the records of an .npy position file.
+     * @param path Path to file written by oat-record.
+     * @param records Packed position records.
+     * @return Number of records.
+     */
+    static size_t loadRecords(const std::string &path, std::vector<char> &records);
+
+    // Packed records of each agent and number of records served from each
+    std::vector<std::vector<char>> records_;
+    uint64_t num_records_ {0};
+
+    // Restart from the first record after the last
+    bool loop_ {false};
+};
+
+}      /* namespace oat */
+#endif /* OAT_POSITIONREPLAY_H */
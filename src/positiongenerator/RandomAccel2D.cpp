@@ -32,6 +32,7 @@ po::options_description RandomAccel2D::options() const
     // Update CLI options
     // Start with base options
     po::options_description local_opts(baseOptions());
+    local_opts.add(roomOptions());
 
     // Add local options
     local_opts.add_options()
@@ -45,27 +46,9 @@ po::options_description RandomAccel2D::options() const
 void RandomAccel2D::applyConfiguration(const po::variables_map &vm,
                                         const config::OptionTable &config_table)
 {
-    // Rate
-    double fs = 1e8; // Very fast s.t. process cannot keep up
-    if (oat::config::getNumericValue<double>(vm, config_table, "rate", fs, 0)) {
-        enforce_sample_clock_ = true;
-    } else {
-        tick_ = clock_.now();
-    }
-    generateSamplePeriod(fs);
-
-    // Number of samples
-    oat::config::getNumericValue<uint64_t>(
-        vm, config_table, "num-samples", num_samples_, 0);
-
-    // Room
-    std::vector<double> r;
-    if (oat::config::getArray<double, 4>(vm, config_table, "room", r)) {
-        room_.x = r[0];
-        room_.y = r[1];
-        room_.width = r[2];
-        room_.height = r[3];
-    }
+    // Rate, number of samples, batch size, and room
+    applyBaseConfiguration(vm, config_table);
+    applyRoomConfiguration(vm, config_table);
 
     // Acceleration
     double a;
@@ -78,10 +61,12 @@ void RandomAccel2D::applyConfiguration(const po::variables_map &vm,
     createStaticMatracies();
 }
 
-bool RandomAccel2D::generatePosition(oat::Position2D &position)
+size_t RandomAccel2D::generateBatch(std::vector<oat::Position2D> &batch)
 {
+    size_t s = 0;
+    for (; s < batch_steps_ && it_ < num_samples_; s++, it_++) {
 
-    if (it_ < num_samples_) {
+        auto &position = batch[s];
 
         // Simulate one step of random, but smooth, motion
         simulateMotion();
@@ -95,13 +80,9 @@ bool RandomAccel2D::generatePosition(oat::Position2D &position)
         position.velocity_valid = true;
         position.velocity.x = state_(1);
         position.velocity.y = state_(3);
-
-        it_++;
-
-        return false;
     }
 
-    return true;
+    return s;
 }
 
 void RandomAccel2D::simulateMotion()
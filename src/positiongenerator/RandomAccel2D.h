@@ -23,6 +23,7 @@
 #include <chrono>
 #include <random>
 #include <string>
+#include <vector>
 #include <opencv2/core/mat.hpp>
 
 #include "../../lib/datatypes/Position2D.h"
@@ -60,7 +61,7 @@ private:
     cv::Matx44d state_transition_mat_;
     cv::Matx<double, 4, 2> input_mat_;
 
-    bool generatePosition(oat::Position2D &position) override;
+    size_t generateBatch(std::vector<oat::Position2D> &batch) override;
     void createStaticMatracies(void);
     void simulateMotion(void);
 };
@@ -0,0 +1,131 @@
+//******************************************************************************
+//* File:   RandomSwarm2D.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//*****************************************************************************
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../lib/utility/TOMLSanitize.h"
+#include "../../lib/datatypes/Position2D.h"
+
+#include "RandomSwarm2D.h"
+
+namespace oat {
+
+po::options_description RandomSwarm2D::options() const
+{
+    // Update CLI options
+    // Start with base options
+    po::options_description local_opts(baseOptions());
+    local_opts.add(roomOptions());
+
+    // Add local options
+    local_opts.add_options()
+        ("agents,N", po::value<size_t>(),
+         "Number of independent agents to simulate. If greater than 1, agent "
+         "k is published to SINK_k. Defaults to 1.")
+        ("sigma-accel,a", po::value<double>(),
+         "Standard deviation of normally-distributed random accelerations")
+        ;
+
+    return local_opts;
+}
+
+void RandomSwarm2D::applyConfiguration(const po::variables_map &vm,
+                                       const config::OptionTable &config_table)
+{
+    // Rate, number of samples, batch size, and room
+    applyBaseConfiguration(vm, config_table);
+    applyRoomConfiguration(vm, config_table);
+
+    // Agents
+    oat::config::getNumericValue<size_t>(
+        vm, config_table, "agents", num_agents_, 1);
+
+    // Acceleration
+    oat::config::getNumericValue<double>(
+        vm, config_table, "sigma-accel", sigma_accel_, 0.0);
+
+    // Start agents at rest, uniformly distributed throughout the room
+    rng_ = cv::RNG(std::random_device{}());
+    x_.resize(num_agents_);
+    y_.resize(num_agents_);
+    vx_.assign(num_agents_, 0.0);
+    vy_.assign(num_agents_, 0.0);
+    for (size_t k = 0; k < num_agents_; k++) {
+        x_[k] = rng_.uniform(room_.x, room_.x + room_.width);
+        y_[k] = rng_.uniform(room_.y, room_.y + room_.height);
+    }
+
+    accel_.create(batch_steps_, 2 * num_agents_, CV_64FC1);
+}
+
+size_t RandomSwarm2D::generateBatch(std::vector<oat::Position2D> &batch)
+{
+    const uint64_t remaining = num_samples_ - it_;
+    const size_t steps
+        = remaining < batch_steps_ ? static_cast<size_t>(remaining) : batch_steps_;
+
+    // Draw the batch's accelerations at once
+    rng_.fill(accel_, cv::RNG::NORMAL, 0.0, sigma_accel_);
+
+    const double ts = sample_period_in_sec_.count();
+    const double a_pos = 0.5 * ts * ts;
+    const double x_min = room_.x, x_max = room_.x + room_.width;
+    const double y_min = room_.y, y_max = room_.y + room_.height;
+    const size_t n = num_agents_;
+
+    double *x = x_.data(), *vx = vx_.data(), *y = y_.data(), *vy = vy_.data();
+
+    for (size_t s = 0; s < steps; s++) {
+
+        const double *ax = accel_.ptr<double>(s);
+        const double *ay = ax + n;
+
+        // Same discrete time model and periodic boundaries as RandomAccel2D,
+        // written as independent loops over agents so they vectorize
+        for (size_t k = 0; k < n; k++) {
+            x[k] += ts * vx[k] + a_pos * ax[k];
+            y[k] += ts * vy[k] + a_pos * ay[k];
+            vx[k] += ts * ax[k];
+            vy[k] += ts * ay[k];
+        }
+
+        for (size_t k = 0; k < n; k++) {
+            x[k] = x[k] < x_min ? x_max : (x[k] > x_max ? x_min : x[k]);
+            y[k] = y[k] < y_min ? y_max : (y[k] > y_max ? y_min : y[k]);
+        }
+
+        auto *out = batch.data() + s * n;
+        for (size_t k = 0; k < n; k++) {
+            out[k].position_valid = true;
+            out[k].position.x = x[k];
+            out[k].position.y = y[k];
+            out[k].velocity_valid = true;
+            out[k].velocity.x = vx[k];
+            out[k].velocity.y = vy[k];
+        }
+    }
+
+    it_ += steps;
+
+    return steps;
+}
+
+} /* namespace oat */
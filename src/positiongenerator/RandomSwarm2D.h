@@ -0,0 +1,65 @@
+//******************************************************************************
+//* File:   RandomSwarm2D.h
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//*****************************************************************************
+
+#ifndef OAT_RANDOMSWARM2D_H
+#define	OAT_RANDOMSWARM2D_H
+
+#include <string>
+#include <vector>
+#include <opencv2/core.hpp>
+
+#include "../../lib/datatypes/Position2D.h"
+
+#include "PositionGenerator.h"
+
+namespace oat {
+
+class RandomSwarm2D : public PositionGenerator {
+
+public:
+
+    /**
+     * Many independent 2D Gaussian random acceleration generators.
+     * Each agent follows the same motion model as RandomAccel2D. Agent
+     * state is held in structure of arrays form and random accelerations for
+     * a whole batch are drawn at once, so the cost per sample is a few
+     * vectorizable arithmetic operations.
+     */
+    using PositionGenerator::PositionGenerator;
+
+private:
+    // Configurable Interface
+    po::options_description options() const override;
+    void applyConfiguration(const po::variables_map &vm,
+                            const config::OptionTable &config_table) override;
+
+    size_t generateBatch(std::vector<oat::Position2D> &batch) override;
+
+    // Random number generator and batch of accelerations, one row per step
+    // holding x accelerations of all agents followed by y accelerations
+    cv::RNG rng_;
+    cv::Mat accel_;
+    double sigma_accel_ {100.0};
+
+    // Simulated agent states
+    std::vector<double> x_, vx_, y_, vy_;
+};
+
+}      /* namespace oat */
+#endif /* OAT_RANDOMSWARM2D_H */
@@ -32,7 +32,9 @@
 #include "../../lib/utility/ProgramOptions.h"
 
 #include "PositionGenerator.h"
+#include "PositionReplay.h"
 #include "RandomAccel2D.h"
+#include "RandomSwarm2D.h"
 
 #define REQ_POSITIONAL_ARGS 2
 
@@ -40,7 +42,9 @@ namespace po = boost::program_options;
 
 const char usage_type[] =
     "TYPE\n"
-    "  rand2D: Randomly accelerating 2D Position";
+    "  rand2D: Randomly accelerating 2D Position\n"
+    "  swarm2D: Many independent randomly accelerating 2D Positions\n"
+    "  replay: Positions replayed from oat-record .npy files";
 
 const char usage_io[] =
     "SINK:\n"
@@ -83,6 +87,8 @@ int main(int argc, char *argv[])
     // Component specializations
     std::unordered_map<std::string, char> type_hash;
     type_hash["rand2D"] = 'a';
+    type_hash["swarm2D"] = 'b';
+    type_hash["replay"] = 'c';
 
     // The component itself
     std::string comp_name = "posigen";
@@ -143,6 +149,16 @@ int main(int argc, char *argv[])
                     posigen = std::make_shared<oat::RandomAccel2D>(sink);
                     break;
                 }
+                case 'b':
+                {
+                    posigen = std::make_shared<oat::RandomSwarm2D>(sink);
+                    break;
+                }
+                case 'c':
+                {
+                    posigen = std::make_shared<oat::PositionReplay>(sink);
+                    break;
+                }
                 default:
                 {
                     printUsage(visible_options, "");
@@ -0,0 +1,41 @@
+#!/usr/bin/python
+
+# Compare two position files written by `oat record` from the same frames.
+# Positions are matched by sample number. Prints the number of matched
+# samples, detections that differ in validity, and the maximum and mean
+# position error, and exits with an error if the maximum exceeds a bound.
+#
+# Usage: compare-positions.py REFERENCE.json TEST.json MAX_ERROR_PX
+
+import json
+import math
+import sys
+
+def load(path):
+    with open(path) as f:
+        return {p['tick']: p for p in json.load(f)['positions']}
+
+ref = load(sys.argv[1])
+test = load(sys.argv[2])
+bound = float(sys.argv[3])
+
+ticks = sorted(set(ref) & set(test))
+mismatched = 0
+errors = []
+for t in ticks:
+    if ref[t]['pos_ok'] != test[t]['pos_ok']:
+        mismatched += 1
+    elif ref[t]['pos_ok']:
+        (x0, y0), (x1, y1) = ref[t]['pos_xy'], test[t]['pos_xy']
+        errors.append(math.hypot(x1 - x0, y1 - y0))
+
+max_err = max(errors) if errors else 0.0
+mean_err = sum(errors) / len(errors) if errors else 0.0
+
+print('samples: %d' % len(ticks))
+print('validity mismatches: %d' % mismatched)
+print('max error: %.3f px' % max_err)
+print('mean error: %.3f px' % mean_err)
+
+if not ticks or mismatched or max_err > bound:
+    sys.exit('FAIL: error bound of %.1f px exceeded' % bound)
@@ -0,0 +1,13 @@
+# CPU time of the pyramid search. Compare against posidet-hsv.sh.
+oat posidet hsv raw pos -c test.toml posidet-hsv-pyramid &
+sleep 1
+time oat frameserve test raw -f $1 -c test.toml test
+
+# Accuracy against a full resolution search of the same frames
+oat posidet hsv raw full &
+oat posidet hsv raw pyr -c test.toml posidet-hsv-pyramid &
+oat record -p full pyr -f /tmp -n hsv-pyramid -o &
+sleep 1
+oat frameserve test raw -f $1 -c test.toml test
+sleep 1
+python compare-positions.py /tmp/full_hsv-pyramid.json /tmp/pyr_hsv-pyramid.json 4
@@ -0,0 +1,12 @@
+# Achieved sample rate of a 4-agent swarm driving position consumers. Each
+# agent publishes num-samples samples (see [posigen-swarm] in test.toml).
+N=1000000
+
+oat posifilt kalman pos_0 flt -c test.toml posifilt-kalman &
+oat posicom mean pos_1 pos_2 com &
+oat record -p pos_3 -b -f /tmp &
+sleep 1
+start=$(date +%s.%N)
+time oat posigen swarm2D pos -c test.toml posigen-swarm
+end=$(date +%s.%N)
+awk "BEGIN { printf \"samples/s per agent: %.0f\n\", $N / ($end - $start) }"
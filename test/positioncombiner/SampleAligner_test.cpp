@@ -0,0 +1,236 @@
+//******************************************************************************
+//* File:   SampleAligner_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <vector>
+
+#include "../../lib/datatypes/Position2D.h"
+#include "../../src/positioncombiner/SampleAligner.h"
+
+using boost::posix_time::milliseconds;
+
+// Valid position with sample count and time
+oat::Position2D sample(uint64_t count, int64_t usec)
+{
+    oat::Sample s;
+    for (uint64_t i = 0; i < count; i++)
+        s.incrementCount(oat::Sample::Microseconds(usec));
+
+    oat::Position2D p("");
+    p.set_sample(s);
+    p.position_valid = true;
+    return p;
+}
+
+SCENARIO ("The exact policy combines samples sharing a sample count.", "[SampleAligner]") {
+
+    GIVEN ("An exact aligner for two SOURCES") {
+
+        oat::SampleAligner aligner;
+        aligner.set_policy(oat::SyncPolicy::EXACT, milliseconds(100));
+        aligner.reset({16, 16});
+
+        std::vector<oat::Position2D> positions(2);
+        const auto t0 = boost::get_system_time();
+
+        WHEN ("Both SOURCES provide the same count") {
+
+            aligner.push(0, sample(1, 1000), t0);
+            aligner.push(1, sample(1, 1000), t0);
+
+            THEN ("They are combined") {
+                REQUIRE( aligner.align(t0, positions) );
+                REQUIRE( positions[0].sample_count() == 1 );
+                REQUIRE( positions[1].sample_count() == 1 );
+                REQUIRE( positions[0].position_valid );
+                REQUIRE( positions[1].position_valid );
+                REQUIRE( aligner.queued(0) == 0 );
+                REQUIRE( aligner.queued(1) == 0 );
+            }
+        }
+
+        WHEN ("One SOURCE has not provided the count") {
+
+            aligner.push(0, sample(1, 1000), t0);
+            aligner.push(0, sample(2, 2000), t0);
+
+            THEN ("The aligner waits on it until the timeout") {
+                REQUIRE_FALSE( aligner.align(t0 + milliseconds(50), positions) );
+                REQUIRE( aligner.waiting_on() == 1 );
+            }
+
+            THEN ("After the timeout, it is presented as invalid") {
+                REQUIRE( aligner.align(t0 + milliseconds(150), positions) );
+                REQUIRE( positions[0].sample_count() == 1 );
+                REQUIRE( positions[0].position_valid );
+                REQUIRE_FALSE( positions[1].position_valid );
+                REQUIRE( aligner.reference() == 0 );
+            }
+
+            THEN ("Its sample arriving after the combination is discarded") {
+                REQUIRE( aligner.align(t0 + milliseconds(150), positions) );
+                aligner.push(1, sample(1, 1000), t0 + milliseconds(160));
+                REQUIRE( aligner.queued(1) == 0 );
+            }
+        }
+
+        WHEN ("A SOURCE provides a count the other skipped") {
+
+            aligner.push(0, sample(2, 2000), t0);
+            aligner.push(1, sample(1, 1000), t0);
+            aligner.push(1, sample(2, 2000), t0);
+
+            THEN ("The oldest count is combined first without waiting") {
+                REQUIRE( aligner.align(t0, positions) );
+                REQUIRE( positions[1].sample_count() == 1 );
+                REQUIRE_FALSE( positions[0].position_valid );
+                REQUIRE( aligner.reference() == 1 );
+
+                REQUIRE( aligner.align(t0, positions) );
+                REQUIRE( positions[0].sample_count() == 2 );
+                REQUIRE( positions[1].sample_count() == 2 );
+            }
+        }
+    }
+}
+
+SCENARIO ("The nearest policy combines samples nearest in time to the first SOURCE's.", "[SampleAligner]") {
+
+    GIVEN ("A nearest aligner for two SOURCES") {
+
+        oat::SampleAligner aligner;
+        aligner.set_policy(oat::SyncPolicy::NEAREST, milliseconds(100));
+        aligner.reset({16, 16});
+
+        std::vector<oat::Position2D> positions(2);
+        const auto t0 = boost::get_system_time();
+
+        aligner.push(0, sample(1, 1000), t0);
+
+        WHEN ("The other SOURCE has only provided earlier samples") {
+
+            aligner.push(1, sample(1, 400), t0);
+
+            THEN ("The aligner waits on it until the timeout") {
+                REQUIRE_FALSE( aligner.align(t0 + milliseconds(50), positions) );
+                REQUIRE( aligner.waiting_on() == 1 );
+                REQUIRE( aligner.align(t0 + milliseconds(150), positions) );
+                REQUIRE( positions[1].sample_usec() == 400 );
+            }
+        }
+
+        WHEN ("The other SOURCE has provided samples on both sides") {
+
+            aligner.push(1, sample(1, 400), t0);
+            aligner.push(1, sample(2, 900), t0);
+            aligner.push(1, sample(3, 1300), t0);
+
+            THEN ("The nearest is combined and is kept for the next reference") {
+                REQUIRE( aligner.align(t0, positions) );
+                REQUIRE( positions[0].sample_usec() == 1000 );
+                REQUIRE( positions[1].sample_usec() == 900 );
+                REQUIRE( aligner.reference() == 0 );
+                REQUIRE( aligner.queued(1) == 2 );
+            }
+        }
+    }
+}
+
+SCENARIO ("The latest policy combines the most recent sample from each SOURCE.", "[SampleAligner]") {
+
+    GIVEN ("A latest aligner for two SOURCES") {
+
+        oat::SampleAligner aligner;
+        aligner.set_policy(oat::SyncPolicy::LATEST, milliseconds(100));
+        aligner.reset({16, 16});
+
+        std::vector<oat::Position2D> positions(2);
+        const auto t0 = boost::get_system_time();
+
+        WHEN ("No SOURCE has provided a sample") {
+
+            THEN ("Nothing is combined") {
+                REQUIRE_FALSE( aligner.align(t0, positions) );
+            }
+        }
+
+        WHEN ("Only one SOURCE has provided samples") {
+
+            aligner.push(0, sample(1, 1000), t0);
+            aligner.push(0, sample(2, 2000), t0);
+
+            THEN ("Its latest is combined with an invalid position") {
+                REQUIRE( aligner.align(t0, positions) );
+                REQUIRE( positions[0].sample_count() == 2 );
+                REQUIRE_FALSE( positions[1].position_valid );
+                REQUIRE( aligner.reference() == 0 );
+            }
+        }
+
+        WHEN ("Both SOURCES have provided samples") {
+
+            aligner.push(0, sample(1, 1000), t0);
+            aligner.push(1, sample(1, 1500), t0);
+
+            THEN ("The most recent sample is the reference") {
+                REQUIRE( aligner.align(t0, positions) );
+                REQUIRE( aligner.reference() == 1 );
+            }
+
+            THEN ("Old samples are reused when one SOURCE updates") {
+                REQUIRE( aligner.align(t0, positions) );
+                REQUIRE_FALSE( aligner.align(t0, positions) );
+
+                aligner.push(0, sample(2, 2000), t0);
+                REQUIRE( aligner.align(t0, positions) );
+                REQUIRE( positions[0].sample_count() == 2 );
+                REQUIRE( positions[1].sample_usec() == 1500 );
+                REQUIRE( positions[1].position_valid );
+                REQUIRE( aligner.reference() == 0 );
+            }
+        }
+    }
+}
+
+SCENARIO ("Sample queues drop their oldest sample when full.", "[SampleAligner]") {
+
+    GIVEN ("An exact aligner with a three sample queue") {
+
+        oat::SampleAligner aligner;
+        aligner.set_policy(oat::SyncPolicy::EXACT, milliseconds(100));
+        aligner.reset({3, 3});
+
+        std::vector<oat::Position2D> positions(2);
+        const auto t0 = boost::get_system_time();
+
+        WHEN ("Five samples are queued") {
+
+            for (uint64_t c = 1; c <= 5; c++)
+                aligner.push(0, sample(c, c * 1000), t0);
+
+            THEN ("The three newest are kept") {
+                REQUIRE( aligner.queued(0) == 3 );
+                REQUIRE( aligner.align(t0 + milliseconds(150), positions) );
+                REQUIRE( positions[0].sample_count() == 3 );
+            }
+        }
+    }
+}
@@ -0,0 +1,257 @@
+//******************************************************************************
+//* File:   TrackSet_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+#include "../../lib/datatypes/MultiPosition2D.h"
+#include "../../lib/datatypes/Position2D.h"
+#include "../../src/positionfilter/TrackSet.h"
+
+namespace {
+
+using Cost = oat::TrackSet::CostMatrix;
+using Assignment = oat::TrackSet::Assignment;
+
+// Cost of leaving a track or detection unassigned
+const double UNASSIGNED {1000.0};
+
+// Cost matrix from a tracks by detections table
+Cost costs(std::initializer_list<std::initializer_list<double>> table)
+{
+    const size_t stride = oat::TrackSet::MAX_TRACKS;
+    Cost cost;
+    cost.fill(UNASSIGNED);
+
+    size_t t = 0;
+    for (const auto &row : table) {
+        size_t d = 0;
+        for (double c : row)
+            cost[t * stride + d++] = c;
+        t++;
+    }
+
+    return cost;
+}
+
+// Set of valid detections
+oat::MultiPosition2D detections(
+    std::initializer_list<std::pair<double, double>> points)
+{
+    oat::MultiPosition2D d("");
+    for (const auto &xy : points) {
+        oat::Position2D p("");
+        p.position = oat::Point2D(xy.first, xy.second);
+        p.position_valid = true;
+        d.push_back(p);
+    }
+    return d;
+}
+
+} // namespace
+
+SCENARIO ("Assignment minimizes total cost or takes the cheapest pairs first.", "[TrackSet]") {
+
+    GIVEN ("Two tracks whose cheapest pair forces an expensive second pair") {
+
+        const Cost cost = costs({{1.0, 2.0},
+                                 {2.0, 9.0}});
+        Assignment track_det;
+
+        WHEN ("Tracks are assigned optimally") {
+
+            oat::TrackSet::assignOptimal(cost, 2, 2, track_det);
+
+            THEN ("Total cost is minimized") {
+                REQUIRE( track_det[0] == 1 );
+                REQUIRE( track_det[1] == 0 );
+            }
+        }
+
+        WHEN ("Tracks are assigned greedily") {
+
+            oat::TrackSet::assignGreedy(cost, 2, 2, UNASSIGNED, track_det);
+
+            THEN ("The cheapest pair is taken first") {
+                REQUIRE( track_det[0] == 0 );
+                REQUIRE( track_det[1] == 1 );
+            }
+        }
+    }
+
+    GIVEN ("More tracks than detections") {
+
+        const Cost cost = costs({{5.0},
+                                 {1.0},
+                                 {3.0}});
+        Assignment track_det;
+
+        WHEN ("Tracks are assigned optimally") {
+
+            oat::TrackSet::assignOptimal(cost, 3, 1, track_det);
+
+            THEN ("Only the closest track is assigned") {
+                REQUIRE( track_det[0] == -1 );
+                REQUIRE( track_det[1] == 0 );
+                REQUIRE( track_det[2] == -1 );
+            }
+        }
+    }
+
+    GIVEN ("More detections than tracks") {
+
+        const Cost cost = costs({{3.0, 1.0, 2.0}});
+        Assignment track_det;
+
+        WHEN ("Tracks are assigned optimally") {
+
+            oat::TrackSet::assignOptimal(cost, 1, 3, track_det);
+
+            THEN ("The track takes the closest detection") {
+                REQUIRE( track_det[0] == 1 );
+            }
+        }
+    }
+
+    GIVEN ("A pair at the gate") {
+
+        const Cost cost = costs({{UNASSIGNED}});
+        Assignment track_det;
+
+        WHEN ("Tracks are assigned greedily") {
+
+            oat::TrackSet::assignGreedy(cost, 1, 1, UNASSIGNED, track_det);
+
+            THEN ("The pair is not assigned") {
+                REQUIRE( track_det[0] == -1 );
+            }
+        }
+    }
+}
+
+SCENARIO ("Tracks are confirmed after hits and deleted after misses.", "[TrackSet]") {
+
+    GIVEN ("A tracker that confirms after 3 hits and deletes after 2 misses") {
+
+        oat::TrackSet tracks;
+        tracks.set_gating(3.0, 3, 2);
+        oat::MultiPosition2D tracked("");
+        const double dt = 0.1;
+
+        WHEN ("An object is detected twice") {
+
+            tracks.update(detections({{10, 10}}), dt, tracked);
+            tracks.update(detections({{10, 10}}), dt, tracked);
+
+            THEN ("Its track is tentative and not published") {
+                REQUIRE( tracks.size() == 1 );
+                REQUIRE( tracked.size() == 0 );
+            }
+        }
+
+        WHEN ("A tentative track misses") {
+
+            tracks.update(detections({{10, 10}}), dt, tracked);
+            tracks.update(detections({}), dt, tracked);
+
+            THEN ("It is deleted") {
+                REQUIRE( tracks.size() == 0 );
+            }
+        }
+
+        WHEN ("An object is detected three times") {
+
+            for (int i = 0; i < 3; i++)
+                tracks.update(detections({{10, 10}}), dt, tracked);
+
+            THEN ("Its track is confirmed and published") {
+                REQUIRE( tracked.size() == 1 );
+                REQUIRE( tracked.id(0) == 0 );
+                REQUIRE( tracked[0].position.x == Approx(10) );
+                REQUIRE( tracked[0].position.y == Approx(10) );
+            }
+
+            AND_WHEN ("It is then missed twice") {
+
+                tracks.update(detections({}), dt, tracked);
+                tracks.update(detections({}), dt, tracked);
+
+                THEN ("Its predicted position is still published") {
+                    REQUIRE( tracked.size() == 1 );
+                }
+            }
+
+            AND_WHEN ("It is then missed three times") {
+
+                for (int i = 0; i < 3; i++)
+                    tracks.update(detections({}), dt, tracked);
+
+                THEN ("It is deleted") {
+                    REQUIRE( tracks.size() == 0 );
+                    REQUIRE( tracked.size() == 0 );
+                }
+            }
+
+            AND_WHEN ("A detection appears far outside the gate") {
+
+                tracks.update(detections({{1000, 1000}}), dt, tracked);
+
+                THEN ("It starts a new track instead of updating the old one") {
+                    REQUIRE( tracks.size() == 2 );
+                    REQUIRE( tracked.size() == 1 );
+                    REQUIRE( tracked.id(0) == 0 );
+                    REQUIRE( tracked[0].position.x == Approx(10) );
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("Track IDs follow their objects.", "[TrackSet]") {
+
+    GIVEN ("Two confirmed tracks") {
+
+        oat::TrackSet tracks;
+        tracks.set_gating(3.0, 1, 2);
+        oat::MultiPosition2D tracked("");
+
+        tracks.update(detections({{0, 0}, {100, 0}}), 0.1, tracked);
+        REQUIRE( tracked.size() == 2 );
+
+        const uint32_t id_left
+            = tracked[0].position.x < 50 ? tracked.id(0) : tracked.id(1);
+
+        WHEN ("The objects are detected in the opposite order") {
+
+            tracks.update(detections({{100, 0}, {0, 0}}), 0.1, tracked);
+
+            THEN ("Each keeps its ID") {
+                REQUIRE( tracked.size() == 2 );
+                for (size_t i = 0; i < tracked.size(); i++) {
+                    const bool left = tracked[i].position.x < 50;
+                    REQUIRE( (tracked.id(i) == id_left) == left );
+                }
+            }
+        }
+    }
+}
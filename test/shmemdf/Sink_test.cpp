@@ -181,5 +181,12 @@ SCENARIO ("Sink<SharedFrameHeader> must bind() before waiting, posting, or alloc
                 REQUIRE_THROWS( mat = sink.retrieve(cols, rows, type, color); );
             }
         }
+
+        WHEN ("When the sink calls set_roi() before binding a segment") {
+
+            THEN ("The the sink shall throw") {
+                REQUIRE_THROWS( sink.set_roi(cv::Rect(0, 0, 10, 10)); );
+            }
+        }
     }
 }
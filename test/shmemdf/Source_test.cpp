@@ -214,5 +214,39 @@ SCENARIO ("Connected sources can retrieve shared objects to mutate them.", "[Sou
     }
 }
 
+SCENARIO ("waitUntil() gives up at its deadline if the sink has not written.", "[Source]") {
+
+    GIVEN ("A bound Sink<int> and a connected Source<int> with common node address") {
+
+        oat::Sink<int> sink;
+        oat::Source<int> source;
+
+        INFO ("The sink binds a node");
+        sink.bind(node_addr);
+
+        INFO ("The source connects to the node");
+        source.touch(node_addr);
+        source.connect();
+
+        WHEN ("The sink has not written and the source calls waitUntil()") {
+            THEN ("The source shall time out") {
+                REQUIRE_FALSE( source.waitUntil(boost::get_system_time() + oat::msec_t(20)) );
+                REQUIRE_FALSE( source.waitUntil(boost::get_system_time()) );
+            }
+        }
+
+        WHEN ("The sink writes and the source calls waitUntil()") {
+
+            sink.wait();
+            sink.post();
+
+            THEN ("The source shall complete the wait and then post()") {
+                REQUIRE( source.waitUntil(boost::get_system_time() + oat::msec_t(20)) );
+                REQUIRE( source.sink_state() == oat::NodeState::SINK_BOUND );
+                REQUIRE_NOTHROW( source.post(); );
+            }
+        }
+    }
+}
 
 // TODO: specialization tests
@@ -0,0 +1,194 @@
+//******************************************************************************
+//* File:   DetectorFunc_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "../../src/positiondetector/DetectorFunc.h"
+
+namespace {
+
+// Wide enough that each band is only a few dozen rows, and tall enough that
+// every worker stripe holds several bands
+const cv::Size FRAME_SIZE {2048, 600};
+
+// Worker counts. Odd counts give stripes that do not align with bands.
+const int THREADS[] {1, 2, 3, 8};
+
+// Smooth random frame, so that classification yields blobs that survive
+// morphology, plus pixel noise so that it also yields specks that do not
+cv::Mat testFrame(const int type)
+{
+    cv::Mat coarse(FRAME_SIZE.height / 16, FRAME_SIZE.width / 16, type);
+    cv::randu(coarse, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    cv::Mat frame, noise(FRAME_SIZE, type);
+    cv::resize(coarse, frame, FRAME_SIZE, 0, 0, cv::INTER_LINEAR);
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(32));
+    frame += noise;
+
+    return frame;
+}
+
+// Whole frame reference
+cv::Mat morph(cv::Mat binary, const cv::Mat &erode, const cv::Mat &dilate)
+{
+    if (!erode.empty())
+        cv::erode(binary, binary, erode);
+    if (!dilate.empty())
+        cv::dilate(binary, binary, dilate);
+
+    return binary;
+}
+
+// Kernels whose combined apron spans several bands' worth of overlap
+const cv::Mat ERODE
+    = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(9, 13));
+const cv::Mat DILATE
+    = cv::getStructuringElement(cv::MORPH_RECT, cv::Size(15, 21));
+
+}
+
+SCENARIO ("thresholdMorph() matches inRange(), erode() and dilate().", "[DetectorFunc]") {
+
+    GIVEN ("A smooth, noisy BGR frame and a passband") {
+
+        const cv::Mat frame = testFrame(CV_8UC3);
+        const cv::Scalar lower(60, 40, 80), upper(200, 180, 220);
+
+        cv::Mat binary;
+        cv::inRange(frame, lower, upper, binary);
+
+        for (const int t : THREADS) {
+
+            WHEN ("The frame is processed by " + std::to_string(t) + " workers") {
+
+                cv::setNumThreads(t);
+
+                cv::Mat out;
+                oat::thresholdMorph(frame, lower, upper, ERODE, DILATE, out);
+                const cv::Mat expected = morph(binary.clone(), ERODE, DILATE);
+
+                THEN ("The result is identical") {
+                    REQUIRE( cv::countNonZero(expected) > 0 );
+                    REQUIRE( cv::norm(out, expected, cv::NORM_INF) == 0 );
+                }
+            }
+
+            WHEN ("Only erosion is applied by " + std::to_string(t) + " workers") {
+
+                cv::setNumThreads(t);
+
+                cv::Mat out;
+                oat::thresholdMorph(frame, lower, upper, ERODE, cv::Mat(), out);
+                const cv::Mat expected = morph(binary.clone(), ERODE, cv::Mat());
+
+                THEN ("The result is identical") {
+                    REQUIRE( cv::norm(out, expected, cv::NORM_INF) == 0 );
+                }
+            }
+
+            WHEN ("No morphology is applied by " + std::to_string(t) + " workers") {
+
+                cv::setNumThreads(t);
+
+                cv::Mat out;
+                oat::thresholdMorph(frame, lower, upper, cv::Mat(), cv::Mat(), out);
+
+                THEN ("The result is the threshold") {
+                    REQUIRE( cv::norm(out, binary, cv::NORM_INF) == 0 );
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("bitplaneMorph() matches a bit test, erode() and dilate().", "[DetectorFunc]") {
+
+    GIVEN ("A smooth, noisy classification frame and a class mask") {
+
+        const cv::Mat bits = testFrame(CV_8UC1);
+        const uchar mask = 0x30;
+
+        cv::Mat binary;
+        cv::bitwise_and(bits, cv::Scalar(mask), binary);
+        binary = binary != 0;
+
+        for (const int t : THREADS) {
+
+            WHEN ("The frame is processed by " + std::to_string(t) + " workers") {
+
+                cv::setNumThreads(t);
+
+                cv::Mat out;
+                oat::bitplaneMorph(bits, mask, ERODE, DILATE, out);
+                const cv::Mat expected = morph(binary.clone(), ERODE, DILATE);
+
+                THEN ("The result is identical") {
+                    REQUIRE( cv::countNonZero(expected) > 0 );
+                    REQUIRE( cv::norm(out, expected, cv::NORM_INF) == 0 );
+                }
+            }
+        }
+    }
+}
+
+SCENARIO ("lutMorph() matches inRange(), erode() and dilate().", "[DetectorFunc]") {
+
+    GIVEN ("A smooth, noisy BGR frame and a table holding a BGR box") {
+
+        const cv::Mat frame = testFrame(CV_8UC3);
+        const cv::Scalar lower(60, 40, 80), upper(200, 180, 220);
+
+        // Color c = (b << 16) | (g << 8) | r is bit c of the table
+        std::vector<uint64_t> lut((1 << 24) / 64, 0);
+        for (uint32_t b = lower[0]; b <= upper[0]; b++)
+            for (uint32_t g = lower[1]; g <= upper[1]; g++)
+                for (uint32_t r = lower[2]; r <= upper[2]; r++) {
+                    const uint32_t c = (b << 16) | (g << 8) | r;
+                    lut[c >> 6] |= uint64_t {1} << (c & 63);
+                }
+
+        cv::Mat binary;
+        cv::inRange(frame, lower, upper, binary);
+
+        for (const int t : THREADS) {
+
+            WHEN ("The frame is processed by " + std::to_string(t) + " workers") {
+
+                cv::setNumThreads(t);
+
+                cv::Mat out;
+                oat::lutMorph(frame, lut.data(), ERODE, DILATE, out);
+                const cv::Mat expected = morph(binary.clone(), ERODE, DILATE);
+
+                THEN ("The result is identical") {
+                    REQUIRE( cv::countNonZero(expected) > 0 );
+                    REQUIRE( cv::norm(out, expected, cv::NORM_INF) == 0 );
+                }
+            }
+        }
+    }
+}
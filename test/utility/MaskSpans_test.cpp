@@ -0,0 +1,173 @@
+//******************************************************************************
+//* File:   MaskSpans_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "../../lib/utility/MaskSpans.h"
+
+SCENARIO ("MaskSpans::apply() matches cv::Mat::setTo().", "[MaskSpans]") {
+
+    GIVEN ("A random mask with runs of every length") {
+
+        cv::Mat mask(240, 320, CV_8UC1);
+        cv::randu(mask, cv::Scalar(0), cv::Scalar(4));
+
+        // Mix of isolated pixels and long runs, including runs that touch
+        // the first and last columns
+        cv::Mat blocks(mask.rows, mask.cols / 16, CV_8UC1);
+        cv::randu(blocks, cv::Scalar(0), cv::Scalar(2));
+        cv::resize(blocks, blocks, mask.size(), 0, 0, cv::INTER_NEAREST);
+        mask = mask.mul(blocks);
+
+        oat::MaskSpans spans;
+        spans.build(mask);
+
+        REQUIRE( spans.size() == mask.size() );
+
+        WHEN ("A single channel frame is masked") {
+
+            cv::Mat frame(mask.size(), CV_8UC1);
+            cv::randu(frame, cv::Scalar(1), cv::Scalar(256));
+
+            cv::Mat expected = frame.clone();
+            expected.setTo(0, mask == 0);
+            spans.apply(frame);
+
+            THEN ("The result is identical") {
+                REQUIRE( cv::norm(frame, expected, cv::NORM_INF) == 0 );
+            }
+        }
+
+        WHEN ("A three channel frame is masked") {
+
+            cv::Mat frame(mask.size(), CV_8UC3);
+            cv::randu(frame, cv::Scalar::all(1), cv::Scalar::all(256));
+
+            cv::Mat expected = frame.clone();
+            expected.setTo(0, mask == 0);
+            spans.apply(frame);
+
+            THEN ("The result is identical") {
+                REQUIRE( cv::norm(frame, expected, cv::NORM_INF) == 0 );
+            }
+        }
+
+        WHEN ("A frame header into a larger buffer is masked") {
+
+            cv::Mat buffer(mask.rows + 20, mask.cols + 20, CV_8UC3);
+            cv::randu(buffer, cv::Scalar::all(1), cv::Scalar::all(256));
+            cv::Mat frame = buffer(cv::Rect(10, 10, mask.cols, mask.rows));
+
+            cv::Mat expected = buffer.clone();
+            expected(cv::Rect(10, 10, mask.cols, mask.rows)).setTo(0, mask == 0);
+            spans.apply(frame);
+
+            THEN ("Only the frame's pixels are changed") {
+                REQUIRE( cv::norm(buffer, expected, cv::NORM_INF) == 0 );
+            }
+        }
+    }
+}
+
+SCENARIO ("MaskSpans::box() summarizes only rectangular masks.", "[MaskSpans]") {
+
+    GIVEN ("An empty mask") {
+
+        cv::Mat mask = cv::Mat::zeros(120, 160, CV_8UC1);
+        oat::MaskSpans spans;
+
+        WHEN ("A single rectangle is kept") {
+
+            const cv::Rect rect(20, 30, 50, 40);
+            mask(rect).setTo(255);
+            spans.build(mask);
+
+            THEN ("The box is the rectangle") {
+                REQUIRE( spans.box() == rect );
+            }
+        }
+
+        WHEN ("The whole frame is kept") {
+
+            mask.setTo(1);
+            spans.build(mask);
+
+            THEN ("The box is the frame") {
+                REQUIRE( spans.box() == cv::Rect(0, 0, mask.cols, mask.rows) );
+            }
+        }
+
+        WHEN ("Nothing is kept") {
+
+            spans.build(mask);
+
+            THEN ("The box is empty") {
+                REQUIRE( spans.box().area() == 0 );
+            }
+        }
+
+        WHEN ("An L-shaped region is kept") {
+
+            mask(cv::Rect(20, 30, 50, 40)).setTo(255);
+            mask(cv::Rect(20, 70, 10, 20)).setTo(255);
+            spans.build(mask);
+
+            THEN ("The box is empty") {
+                REQUIRE( spans.box().area() == 0 );
+            }
+        }
+
+        WHEN ("Two side by side rectangles are kept") {
+
+            mask(cv::Rect(10, 30, 30, 40)).setTo(255);
+            mask(cv::Rect(60, 30, 30, 40)).setTo(255);
+            spans.build(mask);
+
+            THEN ("The box is empty") {
+                REQUIRE( spans.box().area() == 0 );
+            }
+        }
+
+        WHEN ("Two stacked rectangles with a gap are kept") {
+
+            mask(cv::Rect(20, 10, 50, 20)).setTo(255);
+            mask(cv::Rect(20, 60, 50, 20)).setTo(255);
+            spans.build(mask);
+
+            THEN ("The box is empty") {
+                REQUIRE( spans.box().area() == 0 );
+            }
+        }
+
+        WHEN ("A rectangle with a hole is kept") {
+
+            mask(cv::Rect(20, 30, 50, 40)).setTo(255);
+            mask.at<uchar>(50, 40) = 0;
+            spans.build(mask);
+
+            THEN ("The box is empty") {
+                REQUIRE( spans.box().area() == 0 );
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+//******************************************************************************
+//* File:   Rectify_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/calib3d.hpp>
+
+#include "../../lib/utility/Rectify.h"
+
+SCENARIO ("rectify() matches cv::undistort().", "[Rectify]") {
+
+    GIVEN ("A smooth BGR frame and a barrel distorted camera model") {
+
+        cv::Mat frame(480, 640, CV_8UC3);
+        cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+        cv::GaussianBlur(frame, frame, cv::Size(9, 9), 3);
+
+        const cv::Matx33d K {500, 0, 320, 0, 500, 240, 0, 0, 1};
+        const std::vector<double> dist {-0.3, 0.1, 0.001, -0.001, 0.0};
+
+        cv::Mat expected;
+        cv::undistort(frame, expected, K, dist);
+
+        cv::Mat map_xy, map_interp;
+        oat::buildRectifyMaps(K, dist, frame.size(), map_xy, map_interp);
+
+        WHEN ("The frame is rectified on a single thread") {
+
+            cv::setNumThreads(1);
+            cv::Mat result(frame.size(), frame.type());
+            oat::rectify(frame, result, map_xy, map_interp);
+
+            THEN ("The result matches within interpolation tolerance") {
+                REQUIRE( cv::norm(result, expected, cv::NORM_INF) <= 1 );
+            }
+        }
+
+        WHEN ("The frame is rectified in parallel row bands") {
+
+            cv::setNumThreads(4);
+            cv::Mat result(frame.size(), frame.type());
+            oat::rectify(frame, result, map_xy, map_interp);
+
+            THEN ("The result matches within interpolation tolerance") {
+                REQUIRE( cv::norm(result, expected, cv::NORM_INF) <= 1 );
+            }
+        }
+    }
+}
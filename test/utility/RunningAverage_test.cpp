@@ -0,0 +1,127 @@
+//******************************************************************************
+//* File:   RunningAverage_test.cpp
+//* Author: Jon Newman <jpnewman snail mit dot edu>
+//*
+//* Copyright (c) Jon Newman (jpnewman snail mit dot edu)
+//* All right reserved.
+//* This file is part of the Oat project.
+//* This is free software: you can redistribute it and/or modify
+//* it under the terms of the GNU General Public License as published by
+//* the Free Software Foundation, either version 3 of the License, or
+//* (at your option) any later version.
+//* This software is distributed in the hope that it will be useful,
+//* but WITHOUT ANY WARRANTY; without even the implied warranty of
+//* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//* GNU General Public License for more details.
+//* You should have received a copy of the GNU General Public License
+//* along with this source code.  If not, see <http://www.gnu.org/licenses/>.
+//******************************************************************************
+
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+#include "../../lib/utility/RunningAverage.h"
+
+namespace {
+
+// Maximum errors of the fixed-point difference frames and average against
+// cv::accumulateWeighted() over a stream of noisy frames
+void compareToFloat(const int type,
+                    const double alpha,
+                    double &max_frame_err,
+                    double &max_average_err)
+{
+    cv::Mat background(120, 160, type);
+    cv::randu(background, cv::Scalar::all(0), cv::Scalar::all(256));
+
+    cv::Mat average_q8;
+    background.convertTo(average_q8, CV_16U, 256.0);
+
+    cv::Mat average;
+    background.convertTo(average, CV_32F);
+
+    const int32_t alpha_q15 = oat::runningAverageRate(alpha);
+
+    cv::RNG rng(1);
+    max_frame_err = 0;
+    max_average_err = 0;
+
+    for (int k = 0; k < 200; k++) {
+
+        // Noise around a background that steps up every 50 frames
+        cv::Mat noise(background.size(), CV_32FC(background.channels()));
+        rng.fill(noise, cv::RNG::NORMAL, 0, 20);
+
+        cv::Mat frame;
+        background.convertTo(frame, CV_32F);
+        frame += noise + cv::Scalar::all(10 * (k / 50));
+        frame.convertTo(frame, type);
+
+        // Reference: floating point average, rounded to 8 bits
+        cv::accumulateWeighted(frame, average, alpha);
+        cv::Mat average_8u, expected;
+        average.convertTo(average_8u, type);
+        cv::subtract(frame, average_8u, expected);
+
+        oat::subtractRunningAverage(frame, average_q8, alpha_q15);
+
+        cv::Mat average_fixed;
+        average_q8.convertTo(average_fixed, CV_32F, 1.0 / 256.0);
+
+        max_frame_err = std::max(max_frame_err,
+                                 cv::norm(frame, expected, cv::NORM_INF));
+        max_average_err = std::max(
+            max_average_err, cv::norm(average_fixed, average, cv::NORM_INF));
+    }
+}
+
+}
+
+SCENARIO ("subtractRunningAverage() matches cv::accumulateWeighted().", "[RunningAverage]") {
+
+    cv::setNumThreads(4);
+    double frame_err, average_err;
+
+    GIVEN ("A single channel stream and a slow update rate") {
+
+        compareToFloat(CV_8UC1, 0.05, frame_err, average_err);
+
+        THEN ("The difference frames agree within a grey level") {
+            REQUIRE( frame_err <= 1 );
+        }
+
+        THEN ("The averages agree within a tenth of a grey level") {
+            REQUIRE( average_err < 0.1 );
+        }
+    }
+
+    GIVEN ("A three channel stream and a slow update rate") {
+
+        compareToFloat(CV_8UC3, 0.05, frame_err, average_err);
+
+        THEN ("The difference frames agree within a grey level") {
+            REQUIRE( frame_err <= 1 );
+        }
+
+        THEN ("The averages agree within a tenth of a grey level") {
+            REQUIRE( average_err < 0.1 );
+        }
+    }
+
+    GIVEN ("A three channel stream and a fast update rate") {
+
+        compareToFloat(CV_8UC3, 0.5, frame_err, average_err);
+
+        THEN ("The difference frames agree within a grey level") {
+            REQUIRE( frame_err <= 1 );
+        }
+
+        THEN ("The averages agree within a tenth of a grey level") {
+            REQUIRE( average_err < 0.1 );
+        }
+    }
+}